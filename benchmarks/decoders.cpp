@@ -0,0 +1,213 @@
+/**
+ * REST decoders: time spent decoding paged responses
+ *
+ * Builds responses laid out as the exchange sends them (pages of
+ * candles, orders and cancelled order IDs, and the products) and
+ * decodes them page after page into the same output, as the paging
+ * queries do. Each response is copied aside before it is decoded in
+ * place, only the decoding is timed.
+ */
+#include "cryptoconnect/adapters/coinbasepro/rest/decoders.hpp"
+#include "cryptoconnect/helpers/utils/datetime.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace CryptoConnect;
+    using namespace CryptoConnect::CoinbasePro::REST;
+
+    /* Orders and candles decoded per round (override with the first argument) */
+    size_t numRecords = 10000;
+
+    /* Rounds each decoder is timed over (override with the second argument) */
+    size_t numRounds = 50;
+
+    /* Records per page of the exchange's responses */
+    constexpr size_t c_candlesPerPage = 300;
+    constexpr size_t c_ordersPerPage = 1000;
+
+    std::string makeTimestamp(size_t i)
+    {
+        char timestamp[32];
+        std::snprintf(timestamp, sizeof(timestamp), "2022-%02zu-%02zuT%02zu:%02zu:%02zu.%06zuZ",
+                      1 + i % 12, 1 + i % 28, i % 24, i % 60, (i / 60) % 60, (i * 7919) % 1000000);
+        return timestamp;
+    }
+
+    /* Pages of [time, low, high, open, close, volume] */
+    std::vector<std::string> makeCandlePages()
+    {
+        std::vector<std::string> pages;
+        for (size_t first = 0; first < numRecords; first += c_candlesPerPage)
+        {
+            std::string page = "[";
+            for (size_t i = first; i < std::min(first + c_candlesPerPage, numRecords); i++)
+            {
+                char candle[128];
+                std::snprintf(candle, sizeof(candle), "%s[%zu,%.2f,%.2f,%.2f,%.2f,%.8f]",
+                              i == first ? "" : ",", 1641772800 - i * 60,
+                              42755.88 - i % 100, 42806.75 + i % 100, 42780.01, 42790.12, 8.25591271 + i % 7);
+                page += candle;
+            }
+            pages.push_back(page + "]");
+        }
+        return pages;
+    }
+
+    /* Pages of order objects, a tenth of them market orders (price is null) */
+    std::vector<std::string> makeOrderPages()
+    {
+        std::vector<std::string> pages;
+        for (size_t first = 0; first < numRecords; first += c_ordersPerPage)
+        {
+            std::string page = "[";
+            for (size_t i = first; i < std::min(first + c_ordersPerPage, numRecords); i++)
+            {
+                bool const isMarket = i % 10 == 0;
+                char order[512];
+                std::snprintf(order, sizeof(order),
+                              "%s{\"id\":\"c8c4effb-fb92-4413-8f03-%012zx\",\"price\":%s,\"size\":\"0.00100000\","
+                              "\"product_id\":\"%s\",\"side\":\"%s\",\"type\":\"%s\",\"created_at\":\"%s\","
+                              "\"fill_fees\":\"0.0000000000000000\",\"filled_size\":\"0.00000000\","
+                              "\"executed_value\":\"0.0000000000000000\",\"status\":\"%s\",\"settled\":false}",
+                              i == first ? "" : ",", i, isMarket ? "null" : "\"49999.01\"",
+                              i % 2 ? "BTC-USD" : "ETH-USD", i % 3 ? "buy" : "sell", isMarket ? "market" : "limit",
+                              makeTimestamp(i).c_str(), i % 4 ? "open" : "done");
+                page += order;
+            }
+            pages.push_back(page + "]");
+        }
+        return pages;
+    }
+
+    /* Pages of the order IDs confirmed cancelled */
+    std::vector<std::string> makeOrderIdPages()
+    {
+        std::vector<std::string> pages;
+        for (size_t first = 0; first < numRecords; first += c_ordersPerPage)
+        {
+            std::string page = "[";
+            for (size_t i = first; i < std::min(first + c_ordersPerPage, numRecords); i++)
+            {
+                char orderId[64];
+                std::snprintf(orderId, sizeof(orderId), "%s\"c8c4effb-fb92-4413-8f03-%012zx\"", i == first ? "" : ",", i);
+                page += orderId;
+            }
+            pages.push_back(page + "]");
+        }
+        return pages;
+    }
+
+    std::string makeProducts(size_t numProducts)
+    {
+        std::string response = "[";
+        for (size_t i = 0; i < numProducts; i++)
+        {
+            char product[512];
+            std::snprintf(product, sizeof(product),
+                          "%s{\"id\":\"C%zu-USD\",\"base_currency\":\"C%zu\",\"quote_currency\":\"USD\","
+                          "\"base_min_size\":\"0.00100000\",\"base_max_size\":\"280.00000000\","
+                          "\"quote_increment\":\"0.01000000\",\"base_increment\":\"0.00000001\","
+                          "\"display_name\":\"C%zu/USD\",\"min_market_funds\":\"10\",\"max_market_funds\":\"1000000\","
+                          "\"margin_enabled\":false,\"post_only\":false,\"limit_only\":false,\"cancel_only\":false,"
+                          "\"trading_disabled\":false,\"status\":\"online\",\"status_message\":\"\"}",
+                          i == 0 ? "" : ",", i, i, i);
+            response += product;
+        }
+        return response + "]";
+    }
+
+    /* Decodes every page into a fresh output per round, returning the nanoseconds spent per record */
+    template <typename Output, typename Decode>
+    double timePages(std::vector<std::string> const &pages, size_t numDecoded, Decode decode)
+    {
+        std::vector<std::vector<char>> buffers(pages.size());
+        std::chrono::nanoseconds elapsed{0};
+
+        for (size_t round = 0; round < numRounds; round++)
+        {
+            // Decoding clobbers the response, copy them all aside first
+            for (size_t i = 0; i < pages.size(); i++)
+                buffers[i].assign(pages[i].c_str(), pages[i].c_str() + pages[i].size() + 1);
+
+            Output output;
+            auto const start = std::chrono::steady_clock::now();
+            for (auto &buffer : buffers)
+                decode(std::span<char>(buffer.data(), buffer.size() - 1), output);
+            elapsed += std::chrono::steady_clock::now() - start;
+        }
+
+        return static_cast<double>(elapsed.count()) / (numRounds * numDecoded);
+    }
+
+    /* Times every decoder, then the timestamps on their own */
+    void run()
+    {
+        std::vector<std::string> const candlePages = makeCandlePages();
+        std::vector<std::string> const orderPages = makeOrderPages();
+        std::vector<std::string> const orderIdPages = makeOrderIdPages();
+        std::vector<std::string> const productsResponse = {makeProducts(500)};
+
+        std::printf("%zu records per round, %zu rounds\n\n", numRecords, numRounds);
+        std::printf("%-16s %8s %14s\n", "decoder", "pages", "ns/record");
+
+        std::string const productId = "BTC-USD";
+        std::printf("%-16s %8zu %14.1f\n", "candles", candlePages.size(),
+                    timePages<Events::bars_t>(
+                        candlePages, numRecords,
+                        [&](std::span<char> page, Events::bars_t &output)
+                        { Decoders::parseBars(productId, page, output); }));
+
+        std::printf("%-16s %8zu %14.1f\n", "orders", orderPages.size(),
+                    timePages<Orders::ordersDetails_t>(
+                        orderPages, numRecords,
+                        [](std::span<char> page, Orders::ordersDetails_t &output)
+                        { Decoders::parseOrdersDetails(page, output); }));
+
+        std::printf("%-16s %8zu %14.1f\n", "order IDs", orderIdPages.size(),
+                    timePages<Orders::orderIds_t>(
+                        orderIdPages, numRecords,
+                        [](std::span<char> page, Orders::orderIds_t &output)
+                        { Decoders::parseOrderIds(page, output); }));
+
+        std::printf("%-16s %8zu %14.1f\n", "products", productsResponse.size(),
+                    timePages<Products::productMap_t>(
+                        productsResponse, 500,
+                        [](std::span<char> page, Products::productMap_t &output)
+                        { Decoders::parseProducts(page, output); }));
+
+        // Timestamps on their own, as found in the orders
+        std::vector<std::string> timestamps(numRecords);
+        for (size_t i = 0; i < numRecords; i++)
+            timestamps[i] = makeTimestamp(i);
+
+        uint64_t checksum = 0;
+        auto const start = std::chrono::steady_clock::now();
+        for (size_t round = 0; round < numRounds; round++)
+            for (auto const &timestamp : timestamps)
+                checksum += Utils::Datetime::isostringToEpoch<std::chrono::nanoseconds>(timestamp);
+        std::chrono::nanoseconds const elapsed = std::chrono::steady_clock::now() - start;
+
+        std::printf("%-16s %8s %14.1f   (checksum %llu)\n", "timestamps", "-",
+                    static_cast<double>(elapsed.count()) / (numRounds * numRecords),
+                    static_cast<unsigned long long>(checksum));
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 1)
+        numRecords = std::strtoull(argv[1], nullptr, 10);
+    if (argc > 2)
+        numRounds = std::strtoull(argv[2], nullptr, 10);
+
+    run();
+}
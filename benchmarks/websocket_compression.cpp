@@ -0,0 +1,328 @@
+/**
+ * permessage-deflate: bytes on the wire against CPU spent inflating
+ *
+ * Streams the same feed-like messages from a local websocket server
+ * to the client, uncompressed and then at several window sizes, and
+ * reports the bytes received off the socket along with the thread CPU
+ * time the client spent per read. Inflating is the extra read CPU of
+ * each compressed run over the uncompressed one.
+ */
+#include "cryptoconnect/helpers/network/websockets/client.hpp"
+#include "cryptoconnect/helpers/network/tls/context.hpp"
+
+#include <boost/beast/core.hpp>
+#include <boost/beast/ssl.hpp>
+#include <boost/beast/websocket.hpp>
+#include <boost/beast/websocket/ssl.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/ssl/context.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/asio/use_future.hpp>
+#include <boost/asio/write.hpp>
+
+#include <openssl/evp.h>
+#include <openssl/ssl.h>
+#include <openssl/x509.h>
+#include <openssl/x509v3.h>
+
+#include <zlib.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    /* Frames streamed per run (override with the first argument) */
+    size_t numFrames = 200000;
+
+    struct Run
+    {
+        char const *name_;
+        Network::WebSockets::Compression compression_;
+    };
+
+    /* Self-signed certificate for localhost, trusted by the client's context */
+    struct Certificate
+    {
+        EVP_PKEY *key_;
+        X509 *cert_;
+
+        Certificate()
+        {
+            this->key_ = EVP_EC_gen("P-256");
+            this->cert_ = X509_new();
+            if (!this->key_ || !this->cert_)
+                throw std::runtime_error("Failed to allocate the certificate");
+
+            X509_set_version(this->cert_, 2);
+            ASN1_INTEGER_set(X509_get_serialNumber(this->cert_), 1);
+            X509_gmtime_adj(X509_getm_notBefore(this->cert_), 0);
+            X509_gmtime_adj(X509_getm_notAfter(this->cert_), 3600);
+            X509_set_pubkey(this->cert_, this->key_);
+
+            X509_NAME *name = X509_get_subject_name(this->cert_);
+            X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC,
+                                       reinterpret_cast<unsigned char const *>("localhost"), -1, -1, 0);
+            X509_set_issuer_name(this->cert_, name);
+
+            X509V3_CTX ctx;
+            X509V3_set_ctx_nodb(&ctx);
+            X509V3_set_ctx(&ctx, this->cert_, this->cert_, nullptr, nullptr, 0);
+            X509_EXTENSION *san = X509V3_EXT_conf_nid(nullptr, &ctx, NID_subject_alt_name, "DNS:localhost");
+            X509_add_ext(this->cert_, san, -1);
+            X509_EXTENSION_free(san);
+
+            if (!X509_sign(this->cert_, this->key_, EVP_sha256()))
+                throw std::runtime_error("Failed to sign the certificate");
+        }
+
+        ~Certificate()
+        {
+            X509_free(this->cert_);
+            EVP_PKEY_free(this->key_);
+        }
+    };
+
+    /* Level 2 updates and tickers shaped like the feed's (prices and sizes walk so they do not repeat exactly) */
+    std::vector<std::string> makeMessages()
+    {
+        static char const *const productIds[] = {"BTC-USD", "ETH-USD", "SOL-USD", "ADA-USD"};
+
+        std::vector<std::string> messages;
+        uint64_t seed = 42;
+        char message[512];
+
+        for (size_t i = 0; i < 4096; i++)
+        {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            char const *productId = productIds[(seed >> 33) % 4];
+            double const price = 20000.0 + (seed >> 40) % 100000 / 100.0;
+            double const size = (seed >> 20) % 1000000 / 1e6;
+            unsigned const micros = (seed >> 12) % 1000000;
+
+            if (i % 8)
+                std::snprintf(message, sizeof(message),
+                              "{\"type\":\"l2update\",\"product_id\":\"%s\",\"changes\":[[\"%s\",\"%.2f\",\"%.8f\"]],"
+                              "\"time\":\"2026-10-18T20:59:17.%06uZ\"}",
+                              productId, seed & 1 ? "buy" : "sell", price, size, micros);
+            else
+                std::snprintf(message, sizeof(message),
+                              "{\"type\":\"ticker\",\"sequence\":%llu,\"product_id\":\"%s\",\"price\":\"%.2f\","
+                              "\"open_24h\":\"%.2f\",\"volume_24h\":\"%.8f\",\"low_24h\":\"%.2f\",\"high_24h\":\"%.2f\","
+                              "\"volume_30d\":\"%.8f\",\"best_bid\":\"%.2f\",\"best_ask\":\"%.2f\",\"side\":\"%s\","
+                              "\"time\":\"2026-10-18T20:59:17.%06uZ\",\"trade_id\":%zu,\"last_size\":\"%.8f\"}",
+                              static_cast<unsigned long long>(seed >> 24), productId, price,
+                              price * 0.98, size * 1e4, price * 0.97, price * 1.02, size * 3e5,
+                              price - 0.01, price + 0.01, seed & 1 ? "buy" : "sell", micros, i, size);
+
+            messages.emplace_back(message);
+        }
+
+        return messages;
+    }
+
+    /* Appends a server (unmasked) text frame header */
+    void appendHeader(std::string &output, size_t size, bool isCompressed)
+    {
+        output.push_back(static_cast<char>(isCompressed ? 0xC1 : 0x81)); // FIN, RSV1 if deflated, text
+
+        if (size < 126)
+            output.push_back(static_cast<char>(size));
+        else if (size < 65536)
+        {
+            output.push_back(126);
+            for (int shift = 8; shift >= 0; shift -= 8)
+                output.push_back(static_cast<char>(size >> shift));
+        }
+        else
+        {
+            output.push_back(127);
+            for (int shift = 56; shift >= 0; shift -= 8)
+                output.push_back(static_cast<char>(size >> shift));
+        }
+    }
+
+    /**
+     * Accepts one connection and streams the messages to it
+     *
+     * Frames are deflated with zlib and written straight to the TLS
+     * stream rather than by Beast, which fully flushes the compressor
+     * after every message and so never compresses one message against
+     * the previous ones, unlike the exchange.
+     */
+    net::awaitable<void> serve(tcp::acceptor &acceptor, ssl::context &tlsContext,
+                               std::vector<std::string> const &messages, Run const &run)
+    {
+        using server_stream_t = websocket::stream<beast::ssl_stream<beast::tcp_stream>>;
+
+        server_stream_t ws(co_await acceptor.async_accept(net::use_awaitable), tlsContext);
+        co_await ws.next_layer().async_handshake(ssl::stream_base::server, net::use_awaitable);
+
+        websocket::permessage_deflate deflateOption;
+        deflateOption.server_enable = true;
+        ws.set_option(deflateOption);
+        co_await ws.async_accept(net::use_awaitable);
+
+        // Raw deflate with the window the client asked for, keeping its context across messages
+        z_stream zs{};
+        if (run.compression_.isEnabled_ &&
+            deflateInit2(&zs, 6, Z_DEFLATED, -run.compression_.serverMaxWindowBits_, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+            throw std::runtime_error("Failed to initialize the deflater");
+
+        std::string frame, deflated;
+        try
+        {
+            for (size_t i = 0; i < numFrames; i++)
+            {
+                std::string const &message = messages[i % messages.size()];
+                frame.clear();
+
+                if (!run.compression_.isEnabled_)
+                {
+                    appendHeader(frame, message.size(), false);
+                    frame += message;
+                }
+                else
+                {
+                    deflated.resize(deflateBound(&zs, message.size()) + 16);
+                    zs.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(message.data()));
+                    zs.avail_in = message.size();
+                    zs.next_out = reinterpret_cast<Bytef *>(deflated.data());
+                    zs.avail_out = deflated.size();
+                    deflate(&zs, Z_SYNC_FLUSH);
+
+                    // The trailing empty block (00 00 ff ff) is implied by the extension
+                    size_t const size = deflated.size() - zs.avail_out - 4;
+                    appendHeader(frame, size, true);
+                    frame.append(deflated.data(), size);
+                }
+
+                co_await net::async_write(ws.next_layer(), net::buffer(frame), net::use_awaitable);
+            }
+
+            // Hold the connection until the client is done reading
+            beast::flat_buffer buffer;
+            co_await ws.async_read(buffer, net::use_awaitable);
+        }
+        catch (std::exception const &)
+        {
+            // The client drops the connection once it has read everything
+        }
+
+        if (run.compression_.isEnabled_)
+            deflateEnd(&zs);
+    }
+
+    /* Streams a run and returns the client's counters over the reads */
+    Network::WebSockets::Stats stream(Run const &run, ssl::context &serverContext,
+                                      std::vector<std::string> const &messages)
+    {
+        net::io_context serverIoc, clientIoc;
+
+        tcp::acceptor acceptor(serverIoc, tcp::endpoint(net::ip::make_address("127.0.0.1"), 0));
+        std::string const port = std::to_string(acceptor.local_endpoint().port());
+        net::co_spawn(serverIoc, serve(acceptor, serverContext, messages, run), net::detached);
+        std::thread serverThread([&serverIoc]
+                                 { serverIoc.run(); });
+
+        // The client has a thread to itself, so the read timings only cover its own work
+        Network::WebSockets::Stats stats{};
+        {
+            Network::WebSockets::Client client(clientIoc);
+            client.setCompression(run.compression_);
+
+            auto work = net::make_work_guard(clientIoc);
+            std::thread clientThread([&clientIoc]
+                                     { clientIoc.run(); });
+
+            auto reads = net::co_spawn(
+                client.getStrand(),
+                [&client, &port]() -> net::awaitable<Network::WebSockets::Stats>
+                {
+                    co_await client.connect("localhost", port);
+
+                    // Leave the handshakes out
+                    Network::WebSockets::Stats before, after;
+                    client.getStats(before);
+
+                    beast::flat_buffer buffer;
+                    buffer.reserve(WEBSOCKETS_READ_BUFFER_SIZE);
+                    for (size_t i = 0; i < numFrames; i++)
+                        co_await client.read(buffer);
+
+                    client.getStats(after);
+                    after.frames_ -= before.frames_;
+                    after.payloadBytes_ -= before.payloadBytes_;
+                    after.wireBytes_ -= before.wireBytes_;
+                    after.readCpuNanoseconds_ -= before.readCpuNanoseconds_;
+                    co_return after;
+                },
+                net::use_future);
+
+            stats = reads.get();
+
+            work.reset();
+            clientIoc.stop();
+            clientThread.join();
+        }
+
+        serverIoc.stop();
+        serverThread.join();
+        return stats;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 1)
+        numFrames = std::strtoull(argv[1], nullptr, 10);
+
+    Certificate certificate;
+
+    ssl::context serverContext{ssl::context::tlsv13_server};
+    if (!SSL_CTX_use_certificate(serverContext.native_handle(), certificate.cert_) ||
+        !SSL_CTX_use_PrivateKey(serverContext.native_handle(), certificate.key_))
+        throw std::runtime_error("Failed to set the server's certificate");
+
+    X509_STORE_add_cert(
+        SSL_CTX_get_cert_store(Network::TLS::Context::shared("localhost").getContext().native_handle()),
+        certificate.cert_);
+
+    std::vector<std::string> const messages = makeMessages();
+
+    Run const runs[] = {
+        {"uncompressed", Network::WebSockets::Compression(false)},
+        {"deflate 15 bits", Network::WebSockets::Compression(true, 15, 15)},
+        {"deflate 12 bits", Network::WebSockets::Compression(true, 12, 12)},
+        {"deflate 9 bits", Network::WebSockets::Compression(true, 9, 9)},
+    };
+
+    std::printf("%zu frames per run\n\n", numFrames);
+    std::printf("%-16s %10s %12s %12s %8s %14s %14s\n",
+                "run", "negotiated", "payload MB", "wire MB", "ratio", "read ns/frame", "inflate ns/frame");
+
+    double baselineNanoseconds = 0;
+    for (Run const &run : runs)
+    {
+        Network::WebSockets::Stats const stats = stream(run, serverContext, messages);
+        double const readNanoseconds = static_cast<double>(stats.readCpuNanoseconds_) / stats.frames_;
+        // Labelled by what the handshake agreed rather than what was offered
+        if (!stats.isCompressed_)
+            baselineNanoseconds = readNanoseconds;
+
+        std::printf("%-16s %10s %12.2f %12.2f %8.2f %14.0f %14.0f\n",
+                    run.name_, stats.isCompressed_ ? "deflate" : "none",
+                    stats.payloadBytes_ / 1e6, stats.wireBytes_ / 1e6,
+                    static_cast<double>(stats.payloadBytes_) / stats.wireBytes_,
+                    readNanoseconds, readNanoseconds - baselineNanoseconds);
+    }
+}
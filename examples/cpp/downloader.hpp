@@ -4,9 +4,6 @@
 #include "cryptoconnect/structs/events.hpp"
 #include "cryptoconnect/structs/universe.hpp"
 
-#include <string>
-#include <unordered_map>
-
 /* Forward declarations */
 class CBProStrategy;
 
@@ -18,7 +15,7 @@ private:
 public:
     CBProDownloader(CBProStrategy *strategy);
     void downloadLatestBars(Universe::Universe const &universe,
-                            std::unordered_map<std::string, Events::bars_t> &barsDataMap);
+                            Events::barSeriesMap_t &barsDataMap);
 };
 
 #endif
@@ -38,17 +38,16 @@ void CBProUniverseFilter::filterDetails(Universe::Universe &universe)
 
 void CBProUniverseFilter::filterTopPriceVolume(
     Universe::Universe &universe,
-    std::unordered_map<std::string, Events::bars_t> barsDataMap)
+    Events::barSeriesMap_t const &barsDataMap)
 {
     std::unordered_map<std::string, double> priceVolumesMap;
 
     for (auto const &pair : barsDataMap)
     {
         double priceVolume = 0;
-        for (auto const &bar : std::get<1>(pair))
-        {
-            priceVolume += (bar.close_ * bar.vol_);
-        }
+        Events::BarSeries const &series = std::get<1>(pair);
+        for (size_t i = 0; i < series.size(); i++)
+            priceVolume += (series.closes_[i] * series.vols_[i]);
         priceVolumesMap.emplace(std::get<0>(pair), priceVolume);
     }
 
@@ -56,7 +55,7 @@ void CBProUniverseFilter::filterTopPriceVolume(
     int nToExtract = barsDataMap.size() * DOLLAR_VOLUME_PERCENTILE;
     std::vector<std::string> universeVec;
     std::transform(barsDataMap.begin(), barsDataMap.end(), back_inserter(universeVec),
-                   [](std::pair<std::string, Events::bars_t> pair)
+                   [](auto const &pair)
                    { return pair.first; });
     std::partial_sort(universeVec.begin(), universeVec.begin() + nToExtract, universeVec.end(),
                       [&](std::string id1, std::string id2)
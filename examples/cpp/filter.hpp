@@ -19,7 +19,7 @@ public:
     void filterDetails(Universe::Universe &universe);
     void filterTopPriceVolume(
         Universe::Universe &universe,
-        std::unordered_map<std::string, Events::bars_t> barsDataMap);
+        Events::barSeriesMap_t const &barsDataMap);
 };
 
 #endif
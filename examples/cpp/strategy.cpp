@@ -37,7 +37,7 @@ void CBProStrategy::onStart()
     this->universeFilter_.filterDetails(availableUniverse);
 
     // Now we load some bar data
-    std::unordered_map<std::string, Events::bars_t> barsDataMap;
+    Events::barSeriesMap_t barsDataMap;
     this->downloader_.downloadLatestBars(availableUniverse, barsDataMap);
 
     // We then pass the bar data to the price volume filter
@@ -47,16 +47,10 @@ void CBProStrategy::onStart()
     std::vector<std::string> selectedUniverseVec;
     std::copy(availableUniverse.begin(), availableUniverse.end(), std::back_inserter(selectedUniverseVec));
 
-    // Extract the close price from the bars
+    // The close prices are already laid out contiguously per product
     std::unordered_map<std::string, std::vector<double>> closePriceData;
     for (auto const &item : availableUniverse)
-    {
-        closePriceData[item] = std::vector<double>(barsDataMap[item].size());
-        std::transform(
-            barsDataMap[item].begin(), barsDataMap[item].end(),
-            std::back_inserter(closePriceData[item]), [](Events::Bar bar)
-            { return bar.close_; });
-    }
+        closePriceData[item] = barsDataMap[item].closes_;
 
     /**
      * We can also use Python for some help,
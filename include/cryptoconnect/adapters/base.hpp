@@ -6,6 +6,8 @@
 #include "cryptoconnect/structs/products.hpp"
 #include "cryptoconnect/structs/universe.hpp"
 
+#include <span>
+
 /* Forward declarations */
 namespace CryptoConnect
 {
@@ -32,22 +34,59 @@ namespace CryptoConnect
         virtual void updateUniverse(Universe::Universe const &universe) = 0;
         virtual Products::productPtr_t lookupProductDetails(std::string const productId) = 0;
 
+        /* Bars between the ISO 8601 times (throws std::invalid_argument if they or the granularity are malformed) */
         virtual void getBars(std::string const &productId, char const *granularity,
                              std::string const &start, std::string const &end,
                              Events::bars_t &output) = 0;
 
+        /* Bulk history: every product's range is downloaded at once (paced by the rate limit) */
+        virtual void getHistory(std::span<std::string const> productIds, char const *granularity,
+                                std::string const &start, std::string const &end,
+                                Events::barSeriesMap_t &output) = 0;
+
         virtual void placeOrder(Orders::LimitOrder const &order, Orders::OrderResponse &output) = 0;
         virtual void placeOrder(Orders::MarketOrder const &order, Orders::OrderResponse &output) = 0;
 
+        /* Non-blocking: the exchange's response comes back as an OrderAck event */
+        virtual Orders::clientOrderId_t submitOrder(Orders::LimitOrder const &order) = 0;
+        virtual Orders::clientOrderId_t submitOrder(Orders::MarketOrder const &order) = 0;
+
+        /* Pre-staged: encoded ahead of time, only signed and sent once triggered (consumed by the placement or submission) */
+        virtual void stageOrder(Orders::LimitOrder const &order, Orders::StagedOrder &output) = 0;
+        virtual void stageOrder(Orders::MarketOrder const &order, Orders::StagedOrder &output) = 0;
+        virtual void placeOrder(Orders::StagedOrder &&order, Orders::OrderResponse &output) = 0;
+        virtual Orders::clientOrderId_t submitOrder(Orders::StagedOrder &&order) = 0;
+
+        /* Batches: every order is sent at once, responses come back in the batch's order */
+        virtual void placeOrders(std::span<Orders::LimitOrder const> orders, Orders::BatchResponse &output) = 0;
+        virtual void placeOrders(std::span<Orders::MarketOrder const> orders, Orders::BatchResponse &output) = 0;
+        virtual void placeOrders(std::span<Orders::StagedOrder> orders, Orders::BatchResponse &output) = 0;
+
         virtual void getOrder(std::string const &orderId, Orders::OrderDetails &output) = 0;
         virtual void getAllOrders(Orders::Status const status, Orders::ordersDetails_t &output) = 0;
         virtual void getAllOrders(std::string const &productId,
                                   Orders::Status const status,
                                   Orders::ordersDetails_t &output) = 0;
 
+        /* Paginated: each page is handed over as it arrives (every product if productId is empty) */
+        virtual void getAllOrders(std::string const &productId,
+                                  Orders::Status const status,
+                                  Orders::ordersPageHandler_t const &handler) = 0;
+
         virtual bool cancelOrder(std::string const &orderId) = 0;
+
+        /* Non-blocking: the exchange's response comes back as a CancelAck event */
+        virtual Orders::clientOrderId_t cancelOrderAsync(std::string const &orderId) = 0;
+
+        /* Non-blocking, by the client order ID of a submitted order: never sent ahead of the order itself */
+        virtual Orders::clientOrderId_t cancelOrderAsync(Orders::clientOrderId_t const orderClientOrderId) = 0;
+
         virtual void cancelAllOrders(Orders::orderIds_t &output) = 0;
         virtual void cancelAllOrders(std::string const &productId, Orders::orderIds_t &output) = 0;
+
+        /* Bulk: every cancellation is dispatched at once, the IDs confirmed cancelled are appended to the output */
+        virtual void cancelOrders(Orders::orderIds_t const &orderIds, Orders::orderIds_t &output) = 0;
+        virtual void cancelAllOrders(std::span<std::string const> productIds, Orders::orderIds_t &output) = 0;
     };
 }
 
@@ -10,10 +10,14 @@
 #include "./auth.hpp"
 #include "./rest/connector.hpp"
 #include "./rest/bars_scheduler.hpp"
+#include "./rest/candle_cache.hpp"
+#include "./rest/history_downloader.hpp"
+#include "./rest/order_gateway.hpp"
+#include "./rest/product_catalogue.hpp"
 #include "./stream/connector.hpp"
-#include "./stream/handler.hpp"
 
 #include <mutex>
+#include <span>
 #include <string>
 #include <variant>
 
@@ -25,8 +29,8 @@ namespace CryptoConnect::CoinbasePro
         /* Tracks the current subscribed universe */
         Universe::Universe currentUniverse_;
 
-        /* Tracks the products details */
-        Products::productMap_t productMap_;
+        /* Serializes universe updates (each one is diffed against the current universe) */
+        std::mutex universeMutex_;
 
         /* Event queue for helpers to enqueue into and strategy to read from */
         Events::Queue eventQueue_;
@@ -37,12 +41,23 @@ namespace CryptoConnect::CoinbasePro
         /* REST Connector */
         REST::Connector restConnector_{&this->auth_};
 
+        /* Product Catalogue (immutable snapshots, lock-free lookups) */
+        REST::ProductCatalogue productCatalogue_{&this->restConnector_};
+
+        /* Order Gateway (acknowledges into the event queue) */
+        REST::OrderGateway orderGateway_{&this->restConnector_, &this->auth_, &this->eventQueue_};
+
         /* Bars Scheduler */
         REST::BarsScheduler barsScheduler_{&this->restConnector_, &this->eventQueue_, &this->currentUniverse_};
 
-        /* Stream Connector and handler */
-        Stream::Connector streamConnector_{&this->auth_};
-        Stream::Handler streamHandler_{&this->eventQueue_};
+        /* History Downloader */
+        REST::HistoryDownloader historyDownloader_{&this->restConnector_};
+
+        /* Candle Cache (read-through in front of the bar queries) */
+        REST::CandleCache candleCache_{&this->historyDownloader_};
+
+        /* Stream Connector (parses into the event queue) */
+        Stream::Connector streamConnector_{&this->auth_, &this->eventQueue_};
 
     public:
         /* Constructor */
@@ -60,20 +75,47 @@ namespace CryptoConnect::CoinbasePro
         void getBars(std::string const &productId, char const *granularity,
                      std::string const &start, std::string const &end,
                      Events::bars_t &output);
+        void getHistory(std::span<std::string const> productIds, char const *granularity,
+                        std::string const &start, std::string const &end,
+                        Events::barSeriesMap_t &output);
 
         /* Orders */
         void placeOrder(Orders::LimitOrder const &order, Orders::OrderResponse &output);
         void placeOrder(Orders::MarketOrder const &order, Orders::OrderResponse &output);
 
+        Orders::clientOrderId_t submitOrder(Orders::LimitOrder const &order);
+        Orders::clientOrderId_t submitOrder(Orders::MarketOrder const &order);
+
+        void stageOrder(Orders::LimitOrder const &order, Orders::StagedOrder &output);
+        void stageOrder(Orders::MarketOrder const &order, Orders::StagedOrder &output);
+        void placeOrder(Orders::StagedOrder &&order, Orders::OrderResponse &output);
+        Orders::clientOrderId_t submitOrder(Orders::StagedOrder &&order);
+
+        void placeOrders(std::span<Orders::LimitOrder const> orders, Orders::BatchResponse &output);
+        void placeOrders(std::span<Orders::MarketOrder const> orders, Orders::BatchResponse &output);
+        void placeOrders(std::span<Orders::StagedOrder> orders, Orders::BatchResponse &output);
+
         void getOrder(std::string const &orderId, Orders::OrderDetails &output);
         void getAllOrders(Orders::Status const status, Orders::ordersDetails_t &output);
         void getAllOrders(std::string const &productId,
                           Orders::Status const status,
                           Orders::ordersDetails_t &output);
+        void getAllOrders(std::string const &productId,
+                          Orders::Status const status,
+                          Orders::ordersPageHandler_t const &handler);
 
         bool cancelOrder(std::string const &orderId);
+        Orders::clientOrderId_t cancelOrderAsync(std::string const &orderId);
+        Orders::clientOrderId_t cancelOrderAsync(Orders::clientOrderId_t const orderClientOrderId);
         void cancelAllOrders(Orders::orderIds_t &output);
         void cancelAllOrders(std::string const &productId, Orders::orderIds_t &output);
+        void cancelOrders(Orders::orderIds_t const &orderIds, Orders::orderIds_t &output);
+        void cancelAllOrders(std::span<std::string const> productIds, Orders::orderIds_t &output);
+
+        /* Diagnostics (Coinbase Pro specific, public and private REST hosts) */
+        void getPoolStats(Network::HTTP::PoolStats &publicOutput, Network::HTTP::PoolStats &privateOutput);
+        void getThrottleStats(Network::HTTP::throttleStats_t &publicOutput,
+                              Network::HTTP::throttleStats_t &privateOutput);
 
     private:
         /* Event feeding */
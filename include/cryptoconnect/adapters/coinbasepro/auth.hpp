@@ -9,6 +9,7 @@
 
 #include "cryptoconnect/helpers/network/http/session.hpp"
 
+#include <cstdint>
 #include <string>
 
 namespace CryptoConnect::CoinbasePro
@@ -18,6 +19,9 @@ namespace CryptoConnect::CoinbasePro
     private:
         std::string secretKey_;
 
+        /* Keys the signing threads' HMAC contexts to this instance */
+        uint64_t id_;
+
     public:
         std::string apiKey_;
         std::string passPhrase_;
@@ -1,13 +1,6 @@
 #ifndef CRYPTOCONNECT_COINBASEPRO_REST_BARSSCHEDULER_H
 #define CRYPTOCONNECT_COINBASEPRO_REST_BARSSCHEDULER_H
 
-/* Use only 2 threads in sandbox to minimize chances of exceeding rate-limit */
-#if IS_SANDBOX
-#define BAR_QUERY_THREADS 2
-#else
-#define BAR_QUERY_THREADS 8
-#endif
-
 #include "cryptoconnect/structs/events.hpp"
 #include "cryptoconnect/structs/event_queue.hpp"
 #include "cryptoconnect/structs/universe.hpp"
@@ -46,11 +39,11 @@ namespace CryptoConnect::CoinbasePro::REST
             : restConnector_(restConnector), eventQueue_(eventQueue),
               currentUniverse_(currentUniverse){};
 
-        /* Method to be ran in a sleeping thread to initiate the queries in a thread pool */
+        /* Method to be ran in a sleeping thread to initiate the queries every minute */
         void queryBarsForever();
 
     private:
-        /* Method to query for the bars and enqueue in the stream handler */
+        /* Method to query for the bars asynchronously and enqueue them in the stream handler */
         void makeBarQueries();
     };
 }
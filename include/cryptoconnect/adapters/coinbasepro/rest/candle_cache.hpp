@@ -0,0 +1,92 @@
+#ifndef CRYPTOCONNECT_COINBASEPRO_REST_CANDLECACHE_H
+#define CRYPTOCONNECT_COINBASEPRO_REST_CANDLECACHE_H
+
+/* Directory the candle files are kept in (one per product and granularity) */
+#ifndef COINBASEPRO_CANDLE_CACHE_DIRECTORY
+#define COINBASEPRO_CANDLE_CACHE_DIRECTORY ".cryptoconnect/candles"
+#endif
+
+/* Closed bars the exchange may still revise (late trades), never cached and always downloaded again */
+#ifndef COINBASEPRO_CANDLE_CACHE_SETTLE_BARS
+#define COINBASEPRO_CANDLE_CACHE_SETTLE_BARS 3
+#endif
+
+#include "cryptoconnect/helpers/utils/mapped_file.hpp"
+#include "cryptoconnect/structs/events.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+/* Forward declarations */
+namespace CryptoConnect::CoinbasePro::REST
+{
+    class HistoryDownloader;
+}
+
+namespace CryptoConnect::CoinbasePro::REST
+{
+    /* Range of bars known to be cached, gaps within it are intervals without trades (epoch seconds, inclusive) */
+    struct CandleCoverage
+    {
+        uint64_t start_, end_;
+    };
+
+    /* Cached bars of a product, in ascending time and read in place from its mapped file */
+    struct CandleView
+    {
+        std::shared_ptr<Utils::Storage::MappedFile const> file_; // Keeps the mapping alive
+        std::span<CandleCoverage const> coverage_;
+        std::span<uint64_t const> epochTimes_;
+        std::span<double const> opens_, highs_, lows_, closes_, vols_;
+
+        size_t size() const { return this->epochTimes_.size(); }
+    };
+
+    /**
+     * Read-through on-disk candle store in front of the REST bar queries
+     *
+     * Each product and granularity has its own file laid out as columns
+     * (in the machine's byte order) along with the ranges it covers.
+     * Reads map the file and slice the requested range out of it, only
+     * downloading the ranges not covered yet. Settled bars are merged into
+     * the file, which is replaced whole, while the still forming bar and
+     * the last few closed ones are always downloaded and never kept.
+     */
+    class CandleCache
+    {
+    private:
+        REST::HistoryDownloader *historyDownloader_;
+        std::string directory_;
+
+        /* Mapped files by path, swapped for the new version on write-backs */
+        std::unordered_map<std::string, std::shared_ptr<Utils::Storage::MappedFile const>> files_;
+        std::mutex mutex_;
+
+    public:
+        /* Constructor */
+        CandleCache(REST::HistoryDownloader *historyDownloader,
+                    std::string directory = COINBASEPRO_CANDLE_CACHE_DIRECTORY)
+            : historyDownloader_(historyDownloader), directory_(std::move(directory)){};
+
+        /* Reads the bars between start and end (epoch seconds, inclusive) of each product */
+        void read(std::span<std::string const> productIds, uint64_t granularity,
+                  uint64_t start, uint64_t end, Events::barSeriesMap_t &output);
+
+        /* Cached bars of the product (without downloading any) */
+        CandleView view(std::string const &productId, uint64_t granularity);
+
+    private:
+        std::string path(std::string const &productId, uint64_t granularity) const;
+
+        /* Merges the downloaded bars into the product's file and returns its new version */
+        CandleView store(std::string const &productId, uint64_t granularity,
+                         std::span<CandleCoverage const> coverage, CandleView const &downloaded);
+    };
+}
+
+#endif
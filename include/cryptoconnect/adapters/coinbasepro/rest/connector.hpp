@@ -1,15 +1,25 @@
 #ifndef CRYPTOCONNECT_COINBASEPRO_HTTP_CONNECTOR_H
 #define CRYPTOCONNECT_COINBASEPRO_HTTP_CONNECTOR_H
 
-#include "cryptoconnect/helpers/network/http/session.hpp"
+#include "cryptoconnect/helpers/network/http/async_session.hpp"
+#include "cryptoconnect/helpers/network/http/rate_limiter.hpp"
+#include "cryptoconnect/helpers/network/http/retry_policy.hpp"
+#include "cryptoconnect/helpers/network/http/session_pool.hpp"
 #include "cryptoconnect/structs/events.hpp"
 #include "cryptoconnect/structs/orders.hpp"
 #include "cryptoconnect/structs/products.hpp"
 #include "cryptoconnect/structs/universe.hpp"
 
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
 #include <rapidjson/document.h>
 
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <span>
 #include <string>
+#include <utility>
 #include <unordered_set>
 
 #if IS_SANDBOX
@@ -18,12 +28,81 @@
 #define COINBASEPRO_REST_ENDPOINT "api.exchange.coinbase.com"
 #endif
 
+/* Interval at which the idle REST sessions are health-checked and pinged to stay warm */
+#ifndef COINBASEPRO_REST_KEEPALIVE_S
+#define COINBASEPRO_REST_KEEPALIVE_S 30
+#endif
+
+/* Public (per IP) and private (per profile) request rate limits, sustained rate per second and burst */
+#ifndef COINBASEPRO_REST_PUBLIC_RATE
+#define COINBASEPRO_REST_PUBLIC_RATE 10
+#endif
+#ifndef COINBASEPRO_REST_PUBLIC_BURST
+#define COINBASEPRO_REST_PUBLIC_BURST 15
+#endif
+#ifndef COINBASEPRO_REST_PRIVATE_RATE
+#define COINBASEPRO_REST_PRIVATE_RATE 15
+#endif
+#ifndef COINBASEPRO_REST_PRIVATE_BURST
+#define COINBASEPRO_REST_PRIVATE_BURST 30
+#endif
+
+/* Attempts per request and the jittered exponential backoff between them (429s, 5xx and socket errors) */
+#ifndef COINBASEPRO_REST_MAX_ATTEMPTS
+#define COINBASEPRO_REST_MAX_ATTEMPTS 4
+#endif
+#ifndef COINBASEPRO_REST_BACKOFF_BASE_MS
+#define COINBASEPRO_REST_BACKOFF_BASE_MS 100
+#endif
+#ifndef COINBASEPRO_REST_BACKOFF_MAX_MS
+#define COINBASEPRO_REST_BACKOFF_MAX_MS 2000
+#endif
+
+/* Latency after which a bar query is hedged with a second one (0 to disable) */
+#ifndef COINBASEPRO_REST_HEDGE_AFTER_MS
+#define COINBASEPRO_REST_HEDGE_AFTER_MS 750
+#endif
+
+/* Threads driving the asynchronous REST requests (each keeps many requests in flight) */
+#ifndef COINBASEPRO_REST_IO_THREADS
+#define COINBASEPRO_REST_IO_THREADS 2
+#endif
+
+/* Connections each side's asynchronous requests are spread over (only 2 in sandbox to minimize chances of exceeding rate-limit) */
+#ifndef COINBASEPRO_REST_ASYNC_CONNECTIONS
+#if IS_SANDBOX
+#define COINBASEPRO_REST_ASYNC_CONNECTIONS 2
+#else
+#define COINBASEPRO_REST_ASYNC_CONNECTIONS 8
+#endif
+#endif
+
+/* Orders per page of the paginated order queries (1000 at most) */
+#ifndef COINBASEPRO_REST_PAGE_SIZE
+#define COINBASEPRO_REST_PAGE_SIZE 100
+#endif
+
+/* Connections kept open and warm for the batches of orders (one per leg of the expected basket, up to the async connections) */
+#ifndef COINBASEPRO_REST_WARM_ORDER_CONNECTIONS
+#define COINBASEPRO_REST_WARM_ORDER_CONNECTIONS COINBASEPRO_REST_ASYNC_CONNECTIONS
+#endif
+
+/* Connections kept open and warm for the cancellations alone */
+#ifndef COINBASEPRO_REST_WARM_CANCEL_CONNECTIONS
+#define COINBASEPRO_REST_WARM_CANCEL_CONNECTIONS 2
+#endif
+
 /* Forward declarations */
 namespace CryptoConnect::CoinbasePro
 {
     class Auth;
 }
 
+namespace CryptoConnect::CoinbasePro::REST
+{
+    class ProductCatalogue;
+}
+
 namespace CryptoConnect::CoinbasePro::REST
 {
     class Connector
@@ -31,15 +110,61 @@ namespace CryptoConnect::CoinbasePro::REST
         /* Allow friend BarsScheduler to query raw bars */
         friend class BarsScheduler;
 
+        /* Allow friend OrderGateway to encode orders and parse responses */
+        friend class OrderGateway;
+
+        /* Allow friend HistoryDownloader to query raw bars */
+        friend class HistoryDownloader;
+
+        /* Allow friend ProductCatalogue to query the products */
+        friend class ProductCatalogue;
+
     private:
-        Network::HTTP::Session publicSession_{COINBASEPRO_REST_ENDPOINT, "443"};
-        Network::HTTP::Session privateSession_{COINBASEPRO_REST_ENDPOINT, "443"};
+        /* Warm keep-alive sessions shared by every thread */
+        Network::HTTP::SessionPool publicPool_{COINBASEPRO_REST_ENDPOINT, "443"};
+        Network::HTTP::SessionPool privatePool_{COINBASEPRO_REST_ENDPOINT, "443"};
+
+        /* Shared by every request on each side (including the order gateway's) */
+        Network::HTTP::RateLimiter publicLimiter_{COINBASEPRO_REST_PUBLIC_RATE, COINBASEPRO_REST_PUBLIC_BURST};
+        Network::HTTP::RateLimiter privateLimiter_{COINBASEPRO_REST_PRIVATE_RATE, COINBASEPRO_REST_PRIVATE_BURST};
+
+        Network::HTTP::RetryPolicy retryPolicy_{
+            COINBASEPRO_REST_MAX_ATTEMPTS,
+            std::chrono::milliseconds(COINBASEPRO_REST_BACKOFF_BASE_MS),
+            std::chrono::milliseconds(COINBASEPRO_REST_BACKOFF_MAX_MS),
+            std::chrono::milliseconds(COINBASEPRO_REST_HEDGE_AFTER_MS)};
+
+        /* Asynchronous requests multiplexed over a few connections by the io threads */
+        net::io_context ioc_;
+        net::executor_work_guard<net::io_context::executor_type> work_{this->ioc_.get_executor()};
+        Network::HTTP::AsyncSession asyncPublicSession_{
+            this->ioc_, COINBASEPRO_REST_ENDPOINT, "443", COINBASEPRO_REST_ASYNC_CONNECTIONS};
+        Network::HTTP::AsyncSession asyncPrivateSession_{
+            this->ioc_, COINBASEPRO_REST_ENDPOINT, "443", COINBASEPRO_REST_ASYNC_CONNECTIONS};
+
+        /* Cancellations never queue behind placements or bar queries */
+        Network::HTTP::AsyncSession asyncCancelSession_{
+            this->ioc_, COINBASEPRO_REST_ENDPOINT, "443", COINBASEPRO_REST_ASYNC_CONNECTIONS};
+
         Auth *auth_;
-        unsigned long uniqueOrderId_{0};
+        std::atomic<Orders::clientOrderId_t> uniqueOrderId_{0};
+
+        /* Products the staged orders are rounded to (none until the owner sets it) */
+        ProductCatalogue const *productCatalogue_{nullptr};
 
     public:
         Connector(Auth *auth);
 
+        /* Sets the catalogue orders are staged against (must outlive the connector) */
+        void setProductCatalogue(ProductCatalogue const *productCatalogue) { this->productCatalogue_ = productCatalogue; }
+
+        /* Reads the session pools' counters (public, private) */
+        void getStats(Network::HTTP::PoolStats &publicOutput, Network::HTTP::PoolStats &privateOutput);
+
+        /* Reads the time spent throttled per endpoint (public, private) */
+        void getThrottleStats(Network::HTTP::throttleStats_t &publicOutput,
+                              Network::HTTP::throttleStats_t &privateOutput);
+
         /* Products */
         void getProducts(Products::productMap_t &productMapOutput,
                          Universe::Universe &availableUniverseOutput);
@@ -55,25 +180,90 @@ namespace CryptoConnect::CoinbasePro::REST
         void placeOrder(Orders::LimitOrder const &order, Orders::OrderResponse &output);
         void placeOrder(Orders::MarketOrder const &order, Orders::OrderResponse &output);
 
+        /* Encodes the order ahead of time, rounded to the product's increments (if given) */
+        void stageOrder(Orders::LimitOrder const &order, Products::Product const *product,
+                        Orders::StagedOrder &output);
+        void stageOrder(Orders::MarketOrder const &order, Products::Product const *product,
+                        Orders::StagedOrder &output);
+
+        /* Encodes the order ahead of time, rounded to its product's increments once the catalogue lists it */
+        void stageOrder(Orders::LimitOrder const &order, Orders::StagedOrder &output);
+        void stageOrder(Orders::MarketOrder const &order, Orders::StagedOrder &output);
+
+        /* Signs and sends a staged order (consumed) */
+        void placeOrder(Orders::StagedOrder &&order, Orders::OrderResponse &output);
+
+        /* Sends the staged orders at once over parallel connections (paced by the private rate limit, all consumed) */
+        void placeOrders(std::span<Orders::StagedOrder> orders, Orders::BatchResponse &output);
+
         void getOrder(std::string const &orderId, Orders::OrderDetails &output);
         void getAllOrders(Orders::Status const status, Orders::ordersDetails_t &output);
         void getAllOrders(std::string const &produtId,
                           Orders::Status const status,
                           Orders::ordersDetails_t &output);
 
+        /* Pages through the orders (every product if productId is empty), prefetching the next page while one is handled */
+        void getAllOrders(std::string const &productId,
+                          Orders::Status const status,
+                          Orders::ordersPageHandler_t const &handler);
+
         bool cancelOrder(std::string const &orderId);
         void cancelAllOrders(Orders::orderIds_t &output);
         void cancelAllOrders(std::string const &productId, Orders::orderIds_t &output);
 
+        /* Cancels concurrently, the IDs of the orders confirmed cancelled are appended to the output */
+        void cancelOrders(Orders::orderIds_t const &orderIds, Orders::orderIds_t &output);
+        void cancelAllOrders(std::span<std::string const> productIds, Orders::orderIds_t &output);
+
     private:
+        /* Raw bars handed over in place */
         void getRawBars(std::string const &productId, char const *granularity,
                         std::string const &start, std::string const &end,
-                        std::string &output);
+                        Network::HTTP::responseHandler_t const &handler);
+
+        /* Asynchronous raw bars (any completion token: callback, net::use_future or net::use_awaitable) */
+        template <typename CompletionToken>
+        auto getRawBarsAsync(std::string const &productId, char const *granularity,
+                             std::string const &start, std::string const &end,
+                             CompletionToken &&token)
+        {
+            std::string target = "/products/" + productId + "/candles?granularity=" + granularity + "&start=" + start + "&end=" + end;
+            return net::co_spawn(
+                net::make_strand(this->ioc_),
+                Network::HTTP::asyncWithRetries(
+                    this->retryPolicy_, true,
+                    [this, target = std::move(target)]
+                    {
+                        return Network::HTTP::hedged(
+                            this->retryPolicy_,
+                            [this]
+                            { return this->publicLimiter_.asyncAcquire(Network::HTTP::Priority::LOW, "GET /products/candles"); },
+                            [this, target]
+                            { return this->asyncPublicSession_.request(http::verb::get, target); });
+                    }),
+                std::forward<CompletionToken>(token));
+        }
+
+        /* Metered asynchronous public GET (bars make way for orders and cancels) */
+        net::awaitable<std::string> getPublicAsync(Network::HTTP::Priority priority, char const *endpoint,
+                                                   std::string target);
+
+        /* Metered asynchronous private request */
+        net::awaitable<std::string> requestPrivateAsync(Network::HTTP::AsyncSession &session,
+                                                        Network::HTTP::Priority priority, char const *endpoint,
+                                                        http::verb method, std::string target, std::string body = "");
+
+        /* Fetches a page of orders (retried) */
+        std::future<Network::HTTP::response_t> getOrdersPage(std::string target);
+
+        /* Sends a cancellation on the warm cancel connections (retried) */
+        std::future<std::string> sendCancel(char const *endpoint, std::string target);
 
-        void parseOrderResponse(std::string const &orderResponseString,
+        /* Decoders parsing the responses in place (clobbered, the stateless ones live in decoders.hpp) */
+        void parseOrderResponse(std::span<char> orderResponse,
                                 Orders::OrderResponse &output);
 
-        void parseOrderDetails(rapidjson::Value const &obj, Orders::OrderDetails &output);
+        bool parseCancelResponse(std::string const &orderId, std::span<char> response);
     };
 }
 
@@ -0,0 +1,37 @@
+#ifndef CRYPTOCONNECT_COINBASEPRO_REST_DECODERS_H
+#define CRYPTOCONNECT_COINBASEPRO_REST_DECODERS_H
+
+#include "cryptoconnect/structs/events.hpp"
+#include "cryptoconnect/structs/orders.hpp"
+#include "cryptoconnect/structs/products.hpp"
+
+#include <rapidjson/document.h>
+
+#include <span>
+#include <string>
+
+/**
+ * Decoders of the REST responses (internal, used by the connector and its benchmark)
+ *
+ * Responses are parsed in place, clobbering them. Paged responses are
+ * appended to the output, which is sized on the first page only.
+ */
+namespace CryptoConnect::CoinbasePro::REST::Decoders
+{
+    /* Replaces the product map with the products (throws std::runtime_error if unparsable) */
+    void parseProducts(std::span<char> response, Products::productMap_t &productMapOutput);
+
+    /* Appends a page of candles (nothing if the response is not an array) */
+    void parseBars(std::string const &productId, std::span<char> response, Events::bars_t &output);
+
+    /* Decodes an order object */
+    void parseOrderDetails(rapidjson::Value const &obj, Orders::OrderDetails &output);
+
+    /* Appends a page of orders (nothing if the exchange answered with a message) */
+    void parseOrdersDetails(std::span<char> response, Orders::ordersDetails_t &output);
+
+    /* Appends a page of order IDs (nothing if the exchange answered with a message) */
+    void parseOrderIds(std::span<char> response, Orders::orderIds_t &output);
+}
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef CRYPTOCONNECT_COINBASEPRO_REST_HISTORYDOWNLOADER_H
+#define CRYPTOCONNECT_COINBASEPRO_REST_HISTORYDOWNLOADER_H
+
+/* Candles CoinbasePro returns per request at most */
+#ifndef COINBASEPRO_HISTORY_WINDOW_BARS
+#define COINBASEPRO_HISTORY_WINDOW_BARS 300
+#endif
+
+/* Windows requested at once (the rate limiter paces them, this bounds the responses held) */
+#ifndef COINBASEPRO_HISTORY_MAX_IN_FLIGHT
+#define COINBASEPRO_HISTORY_MAX_IN_FLIGHT 32
+#endif
+
+#include "cryptoconnect/structs/events.hpp"
+
+#include <cstdint>
+#include <future>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+/* Forward declarations */
+namespace CryptoConnect::CoinbasePro::REST
+{
+    class Connector;
+}
+
+namespace CryptoConnect::CoinbasePro::REST
+{
+    /**
+     * Downloads the bar history of many products at once
+     *
+     * The range of every product is split into windows of as many bars
+     * as a request returns, which are all fetched concurrently (paced by
+     * the public rate limit) and then ordered, de-duplicated and laid
+     * out as contiguous columns per product.
+     */
+    class HistoryDownloader
+    {
+    private:
+        REST::Connector *restConnector_;
+
+    public:
+        /* Bars of a product between start and end (epoch seconds, inclusive) */
+        struct Range
+        {
+            std::string productId_;
+            uint64_t start_, end_;
+
+            /* Filled by the download (incomplete if any of its windows failed) */
+            Events::BarSeries bars_;
+            bool isComplete_;
+
+            Range(std::string productId, uint64_t start, uint64_t end)
+                : productId_(std::move(productId)), start_(start), end_(end), bars_(), isComplete_(true){};
+        };
+
+        /* Constructor */
+        HistoryDownloader(REST::Connector *restConnector) : restConnector_(restConnector){};
+
+        /* Downloads the bars between start and end (epoch seconds, inclusive) of each product */
+        void download(std::span<std::string const> productIds, uint64_t granularity,
+                      uint64_t start, uint64_t end, Events::barSeriesMap_t &output);
+
+        /* Downloads the bars of each range, all at once */
+        void download(std::span<Range> ranges, uint64_t granularity);
+
+    private:
+        /* Fetches a window of raw bars (retried, never hedged so throttled windows are not doubled) */
+        std::future<std::string> fetchWindow(std::string const &productId, uint64_t granularity,
+                                             uint64_t start, uint64_t end);
+    };
+}
+
+#endif
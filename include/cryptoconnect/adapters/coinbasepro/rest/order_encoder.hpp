@@ -0,0 +1,32 @@
+#ifndef CRYPTOCONNECT_COINBASEPRO_REST_ORDERENCODER_H
+#define CRYPTOCONNECT_COINBASEPRO_REST_ORDERENCODER_H
+
+#include "cryptoconnect/structs/orders.hpp"
+#include "cryptoconnect/structs/products.hpp"
+
+namespace CryptoConnect::CoinbasePro::REST
+{
+    /**
+     * Encodes orders straight into the inline body of a staged order
+     *
+     * Prices are rounded to the nearest quote increment and sizes down
+     * to the base increment, printed with exactly as many decimals as
+     * the increments have. Without a product, numbers are printed in
+     * full (shortest round-trip) rather than cut to 6 decimals. Sizes
+     * rounding to zero or below the product's minimum are rejected.
+     */
+    class OrderEncoder
+    {
+    public:
+        /* Encodes the order (product optional, throws std::invalid_argument if its size is rejected and std::length_error if the body does not fit) */
+        static void encode(Orders::LimitOrder const &order, Orders::clientOrderId_t const clientOrderId,
+                           Products::Product const *product, Orders::StagedOrder &output);
+        static void encode(Orders::MarketOrder const &order, Orders::clientOrderId_t const clientOrderId,
+                           Products::Product const *product, Orders::StagedOrder &output);
+
+        /* Decimals an increment has (e.g. 0.01 --> 2, 1 --> 0) */
+        static int decimals(double increment);
+    };
+}
+
+#endif
@@ -0,0 +1,107 @@
+#ifndef CRYPTOCONNECT_COINBASEPRO_REST_ORDERGATEWAY_H
+#define CRYPTOCONNECT_COINBASEPRO_REST_ORDERGATEWAY_H
+
+/* Threads sending the orders (each on its own gateway connection) */
+#ifndef ORDER_GATEWAY_THREADS
+#define ORDER_GATEWAY_THREADS 4
+#endif
+
+/* Acknowledged orders whose exchange IDs are kept for cancelling them by client order ID (oldest dropped first) */
+#ifndef ORDER_GATEWAY_TRACKED_ORDERS
+#define ORDER_GATEWAY_TRACKED_ORDERS 1024
+#endif
+
+#include "cryptoconnect/helpers/network/http/session_pool.hpp"
+#include "cryptoconnect/structs/event_queue.hpp"
+#include "cryptoconnect/structs/orders.hpp"
+#include "./connector.hpp"
+
+#include <boost/asio/thread_pool.hpp>
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/* Forward declarations */
+namespace CryptoConnect::CoinbasePro
+{
+    class Auth;
+}
+
+namespace CryptoConnect::CoinbasePro::REST
+{
+    /**
+     * Sends orders and cancellations without blocking the caller
+     *
+     * Requests are handed over to the gateway's threads, which send
+     * them on connections of their own (kept apart from the data and
+     * query traffic) and enqueue the exchange's responses as OrderAck
+     * and CancelAck events for the strategy.
+     *
+     * Orders are tracked by client order ID from their submission, so
+     * that a cancellation by client order ID is held back until the
+     * order's submission is acknowledged and is never sent ahead of it.
+     */
+    class OrderGateway
+    {
+    private:
+        /* Cancellation held back until its order's submission is acknowledged */
+        struct QueuedCancel
+        {
+            Orders::clientOrderId_t clientOrderId_;
+            uint64_t submitTime_;
+        };
+
+        /* Order submitted through the gateway */
+        struct TrackedOrder
+        {
+            bool isAcked_{false};
+            Orders::orderId_t orderId_; // Assigned by the exchange once acknowledged
+            std::vector<QueuedCancel> queuedCancels_;
+        };
+
+        REST::Connector *restConnector_;
+        Events::Queue *eventQueue_;
+
+        /* Warm connections dedicated to the order traffic */
+        Network::HTTP::SessionPool sessionPool_{COINBASEPRO_REST_ENDPOINT, "443", ORDER_GATEWAY_THREADS};
+
+        boost::asio::thread_pool threadPool_{ORDER_GATEWAY_THREADS};
+
+        /* Orders by client order ID, along with the acknowledged ones in the order they are dropped */
+        std::unordered_map<Orders::clientOrderId_t, TrackedOrder> trackedOrders_;
+        std::deque<Orders::clientOrderId_t> ackedOrders_;
+        std::mutex trackedOrdersMutex_;
+
+    public:
+        /* Constructor */
+        OrderGateway(REST::Connector *restConnector, Auth *auth, Events::Queue *eventQueue);
+
+        /* Queues the order to be sent (staged ones are consumed), its response comes back as an OrderAck */
+        Orders::clientOrderId_t submitOrder(Orders::LimitOrder const &order);
+        Orders::clientOrderId_t submitOrder(Orders::MarketOrder const &order);
+        Orders::clientOrderId_t submitOrder(Orders::StagedOrder &&order);
+
+        /* Queues the cancellation to be sent, its response comes back as a CancelAck */
+        Orders::clientOrderId_t cancelOrder(Orders::orderId_t const &orderId);
+
+        /* Queues the cancellation of an order submitted through the gateway (sent once the submission is acknowledged) */
+        Orders::clientOrderId_t cancelOrder(Orders::clientOrderId_t const orderClientOrderId);
+
+    private:
+        /* Stages the order on the caller's thread and queues it to be sent */
+        template <typename Order>
+        Orders::clientOrderId_t stageAndSubmit(Order const &order);
+
+        /* Sends a staged order, enqueues its acknowledgement and releases the cancellations held back */
+        void sendOrder(Orders::StagedOrder const &order, uint64_t const submitTime);
+
+        /* Queues a cancellation to be sent on the gateway's threads */
+        void postCancel(Orders::orderId_t orderId, Orders::clientOrderId_t const clientOrderId, uint64_t const submitTime);
+    };
+}
+
+#endif
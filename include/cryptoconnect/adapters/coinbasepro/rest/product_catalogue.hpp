@@ -0,0 +1,97 @@
+#ifndef CRYPTOCONNECT_COINBASEPRO_REST_PRODUCTCATALOGUE_H
+#define CRYPTOCONNECT_COINBASEPRO_REST_PRODUCTCATALOGUE_H
+
+/* Seconds between refreshes of the products */
+#ifndef COINBASEPRO_PRODUCTS_REFRESH_S
+#define COINBASEPRO_PRODUCTS_REFRESH_S 300
+#endif
+
+/* File the latest products response is persisted to for the next start */
+#ifndef COINBASEPRO_PRODUCTS_SNAPSHOT_PATH
+#define COINBASEPRO_PRODUCTS_SNAPSHOT_PATH ".cryptoconnect/products.json"
+#endif
+
+/* Seconds past which the persisted products are too old to serve (the first refresh is awaited instead) */
+#ifndef COINBASEPRO_PRODUCTS_SNAPSHOT_MAX_AGE_S
+#define COINBASEPRO_PRODUCTS_SNAPSHOT_MAX_AGE_S 86400
+#endif
+
+#include "cryptoconnect/structs/products.hpp"
+
+#include <boost/asio/awaitable.hpp>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace net = boost::asio; // from <boost/asio.hpp>
+
+/* Forward declarations */
+namespace CryptoConnect::CoinbasePro::REST
+{
+    class Connector;
+}
+
+namespace CryptoConnect::CoinbasePro::REST
+{
+    /**
+     * Products kept as an immutable snapshot
+     *
+     * Each refresh builds a new catalogue and publishes a pointer to it
+     * with a lock-free atomic store, so a snapshot is a single load and
+     * readers holding a previous catalogue are never disturbed. Every
+     * catalogue published is kept alive for the lifetime of this one
+     * (they are small, refreshed every few minutes and only retired
+     * when the products change). The last response is persisted so the
+     * next start serves the products straight away while they refresh,
+     * unless it is older than COINBASEPRO_PRODUCTS_SNAPSHOT_MAX_AGE_S.
+     */
+    class ProductCatalogue
+    {
+    private:
+        REST::Connector *restConnector_;
+        std::string snapshotPath_;
+
+        std::atomic<Products::cataloguePtr_t> catalogue_{nullptr};
+
+        /* Every catalogue published (never freed while readers may hold them) and the hash of the latest's response */
+        std::vector<std::unique_ptr<Products::Catalogue const>> catalogues_;
+        size_t publishedHash_{0};
+        std::mutex publishMutex_;
+
+        /* Serializes the blocking fetches of a first catalogue */
+        std::mutex fetchMutex_;
+
+    public:
+        /* Constructor */
+        ProductCatalogue(REST::Connector *restConnector,
+                         std::string snapshotPath = COINBASEPRO_PRODUCTS_SNAPSHOT_PATH)
+            : restConnector_(restConnector), snapshotPath_(std::move(snapshotPath)){};
+
+        /* Loads the persisted catalogue and keeps refreshing it in the background */
+        void start();
+
+        /* Latest catalogue, fetched first if none has been published yet (throws std::logic_error on an io thread) */
+        Products::cataloguePtr_t get();
+
+        /* Latest catalogue, fetched first if none has been published yet (safe on the io threads) */
+        net::awaitable<Products::cataloguePtr_t> asyncGet();
+
+        /* Latest catalogue or nullptr if none has been published yet (never blocks) */
+        Products::cataloguePtr_t snapshot() const { return this->catalogue_.load(std::memory_order_acquire); }
+
+    private:
+        net::awaitable<void> refreshForever();
+
+        /* Fetches the raw products (retried) */
+        net::awaitable<std::string> fetch();
+
+        /* Parses the response into a new catalogue to publish, then persists it if asked */
+        void publish(std::string response, bool isPersisted);
+    };
+}
+
+#endif
@@ -2,7 +2,25 @@
 #define CRYPTOCONNECT_COINBASEPRO_STREAM_CONNECTOR_H
 
 #include "cryptoconnect/helpers/network/websockets/client.hpp"
+#include "cryptoconnect/structs/event_queue.hpp"
 #include "cryptoconnect/structs/universe.hpp"
+#include "./pipeline.hpp"
+
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+
+#include <condition_variable>
+#include <ctime>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #if IS_SANDBOX
 #define COINBASEPRO_WS_ENDPOINT "ws-feed-public.sandbox.exchange.coinbase.com"
@@ -10,50 +28,227 @@
 #define COINBASEPRO_WS_ENDPOINT "ws-feed.exchange.coinbase.com"
 #endif
 
+/* Number of websocket connections the universe is sharded across */
+#ifndef COINBASEPRO_WS_CONNECTIONS
+#if IS_SANDBOX
+#define COINBASEPRO_WS_CONNECTIONS 1
+#else
+#define COINBASEPRO_WS_CONNECTIONS 4
+#endif
+#endif
+
+/* Threads running the io_context shared by all the connections */
+#ifndef COINBASEPRO_WS_IO_THREADS
+#define COINBASEPRO_WS_IO_THREADS 1
+#endif
+
+/* Offer permessage-deflate on the feed (trades inbound bandwidth for CPU spent inflating) */
+#ifndef COINBASEPRO_WS_COMPRESSION
+#define COINBASEPRO_WS_COMPRESSION 0
+#endif
+
+/* Window bits for the server's deflate stream (9-15) */
+#ifndef COINBASEPRO_WS_WINDOW_BITS
+#define COINBASEPRO_WS_WINDOW_BITS 15
+#endif
+
+/* Backoff between reconnection attempts (doubles from min up to max) */
+#ifndef COINBASEPRO_WS_RECONNECT_MIN_BACKOFF_MS
+#define COINBASEPRO_WS_RECONNECT_MIN_BACKOFF_MS 250
+#endif
+
+#ifndef COINBASEPRO_WS_RECONNECT_MAX_BACKOFF_MS
+#define COINBASEPRO_WS_RECONNECT_MAX_BACKOFF_MS 30000
+#endif
+
+/* Reconnection attempts before the stream is failed (0 retries forever) */
+#ifndef COINBASEPRO_WS_RECONNECT_ATTEMPTS
+#define COINBASEPRO_WS_RECONNECT_ATTEMPTS 0
+#endif
+
+/* Products per subscription batch on a connection (sized in between from the measured snapshot throughput) */
+#ifndef COINBASEPRO_WS_SUBSCRIBE_MIN_BATCH
+#define COINBASEPRO_WS_SUBSCRIBE_MIN_BATCH 4
+#endif
+
+#ifndef COINBASEPRO_WS_SUBSCRIBE_MAX_BATCH
+#define COINBASEPRO_WS_SUBSCRIBE_MAX_BATCH 64
+#endif
+
+/* Time each batch's snapshots should take to arrive at the measured throughput */
+#ifndef COINBASEPRO_WS_SUBSCRIBE_BATCH_MS
+#define COINBASEPRO_WS_SUBSCRIBE_BATCH_MS 500
+#endif
+
+/* Time after which a batch still missing snapshots no longer holds up the next one */
+#ifndef COINBASEPRO_WS_SUBSCRIBE_TIMEOUT_MS
+#define COINBASEPRO_WS_SUBSCRIBE_TIMEOUT_MS 5000
+#endif
+
 /* Forward declarations */
 namespace CryptoConnect::CoinbasePro
 {
     class Auth;
-
-    namespace Stream
-    {
-        class Handler;
-    }
 }
 
 namespace CryptoConnect::CoinbasePro::Stream
 {
+    /* Maps a product onto one of the connections (productId, numConnections) -> index */
+    using partitioner_t = std::function<size_t(std::string const &, size_t)>;
+
+    /* Called once every subscribed product has a valid book or timed out (nanoseconds taken to get there, products timed out) */
+    using readinessCallback_t = std::function<void(uint64_t, size_t)>;
+
+    /**
+     * Shards the universe across several websocket connections
+     *
+     * Each connection carries a partition of the products (all channels
+     * of a product stay on the same connection) and is read by its own
+     * coroutine, feeding into the shared parsing pipeline. All the
+     * connections are driven by a single io_context.
+     *
+     * Dropped connections are re-established in place with exponential
+     * backoff and resubscribed, and the strategy is kept informed with
+     * FeedStatus events until every book on it is rebuilt.
+     *
+     * Subscriptions are paced: each connection subscribes a batch of
+     * products at a time and only moves on to the next batch once the
+     * snapshots of the last one have arrived, with the batches sized to
+     * the snapshot throughput measured so far.
+     */
     class Connector
     {
     private:
-        Network::WebSockets::Client wsClient_;
+        /* Tracks a connection from its disconnect until all its books are rebuilt */
+        struct Recovery
+        {
+            bool isRecovering_{false};
+            uint64_t disconnectTime_{0};
+            std::unordered_set<std::string> pendingProducts_;
+        };
+
+        /* Declared first so that it outlives the clients' timers and streams */
+        net::io_context ioc_;
+        net::executor_work_guard<net::io_context::executor_type> work_{this->ioc_.get_executor()};
+
+        /* CPU clocks of the threads running the io_context (started on the first connect) */
+        bool isRunning_{false};
+        std::vector<clockid_t> ioClocks_;
+        std::mutex ioClocksMutex_;
+
+        /* Subscriptions of a connection waiting to be sent or on their snapshots */
+        struct Pacing
+        {
+            std::deque<std::string> queuedProducts_;
+            std::unordered_set<std::string> inFlightProducts_;
+            size_t batchSize_{COINBASEPRO_WS_SUBSCRIBE_MIN_BATCH};
+            size_t batchCount_{0}; // Products sent in the last batch
+            uint64_t batchTime_{0};
+        };
+
+        std::vector<std::unique_ptr<Network::WebSockets::Client>> wsClients_;
         Auth *auth_;
+        Events::Queue *eventQueue_;
+
+        /* Products subscribed on each connection (resubscribed on reconnects) */
+        std::vector<Universe::Universe> subscriptions_;
+
+        /* Connection each subscribed product was assigned to, later operations on it follow the record */
+        std::unordered_map<std::string, size_t> assignments_;
+        std::mutex subscriptionsMutex_; // Also guards the partitioning
+
+        /* Recovery state of each connection */
+        std::vector<Recovery> recoveries_;
+        std::mutex recoveriesMutex_;
+
+        /* Pacing of each connection's subscriptions, along with the products still missing a book */
+        std::vector<Pacing> pacings_;
+        std::unordered_set<std::string> unreadyProducts_;
+        size_t timedOutProducts_{0}; // Given up on since readiness started
+        uint64_t readinessStartTime_{0};
+        readinessCallback_t readinessCallback_;
+        std::mutex pacingMutex_;
+        std::condition_variable pacingUpdated_;
+
+        /* Picks the connection for products not pinned by an explicit group */
+        partitioner_t partitioner_;
+
+        /* Products pinned to a connection by explicit groups */
+        std::unordered_map<std::string, size_t> productGroups_;
+
+        /* Parses the frames off the reading threads */
+        Pipeline pipeline_;
+
+        /* First failure among the reading coroutines */
+        std::mutex failureMutex_;
+        std::condition_variable hasFailed_;
+        std::exception_ptr failure_;
 
     public:
         /* Constructor */
-        Connector(Auth *auth);
+        Connector(Auth *auth, Events::Queue *eventQueue,
+                  size_t numConnections = COINBASEPRO_WS_CONNECTIONS);
+
+        /* Replaces the default hash partitioning (throws once products are subscribed) */
+        void setPartitioner(partitioner_t partitioner);
 
-        /* Connects the socket */
+        /* Pins each group of products onto its own connection (group i -> connection i % N, throws once products are subscribed) */
+        void setProductGroups(std::vector<Universe::Universe> const &groups);
+
+        /* Registers the callback for when every subscribed product has a valid book (or timed out without one) */
+        void setReadinessCallback(readinessCallback_t callback);
+
+        /* Starts the io_context threads and connects the sockets */
         void connect();
 
-        /* Loops and calls the callback on receiving a message */
-        void streamForever(Handler &handler);
+        /* Reads every connection in its own coroutine and hands the frames over to the parsing pipeline */
+        void streamForever();
 
-        /* Subscribes to products */
+        /* Reads the websockets' wire and payload counters (summed across connections, CPU of the io threads) */
+        void getStats(Network::WebSockets::Stats &output);
+
+        /* Subscribes to products (each on its own connection, paced in batches) */
         void subscribeProducts(Universe::Universe const &universe);
 
-        /* Unsubscribes to products */
+        /* Unsubscribes to products (each on its own connection) */
         void unsubscribeProducts(Universe::Universe const &universe);
 
     private:
+        /* Picks the connection for a product being subscribed (subscriptions lock held) */
+        size_t partition(std::string const &productId) const;
+
+        /* Throws if any product has been assigned a connection (subscriptions lock held) */
+        void checkUnassigned() const;
+
+        /* Queues products for a connection to subscribe in its next batches (pacing lock held) */
+        void queueSubscriptions(size_t connection, Universe::Universe const &universe);
+
+        /* Sends every connection its next batch of subscriptions as soon as its last one is done */
+        void paceSubscriptionsForever();
+
+        /* Loops and hands the frames received on a connection over to the parsing pipeline */
+        net::awaitable<void> readForever(size_t connection);
+
+        /* Re-establishes a dropped connection and resubscribes its products */
+        net::awaitable<void> recover(size_t connection, std::string reason);
+
+        /* Called by the parsers whenever a product's book is rebuilt */
+        void onSnapshot(std::string const &productId);
+
+        /* Marks a product as no longer pending (snapshotted or unsubscribed), reporting readiness with the last one */
+        void settleSubscription(size_t connection, std::string const &productId, bool const isSnapshot);
+
+        /* Reports that no product is pending anymore (pacing lock not held) */
+        void reportReadiness(size_t connection, uint64_t startTime, uint64_t readyTime, size_t numTimedOut);
+
+        /* Marks a product's book as no longer pending, completing the recovery with the last one */
+        void settleRecovery(size_t connection, std::string const &productId);
+
         /* Constructs the subscription message from the type and the unvierse */
         void makeSubscriptionMessage(
             std::string const type,
             Universe::Universe const &universe,
             std::string &output);
-
-        /* Keeps the socket alive by pinging */
-        void keepAlive();
     };
 }
 
@@ -1,24 +1,43 @@
 #ifndef CRYPTOCONNECT_COINBASEPRO_STREAM_HANDLER_H
 #define CRYPTOCONNECT_COINBASEPRO_STREAM_HANDLER_H
 
+/* Bytes preallocated for the parsed values of a message (larger snapshots spill onto the heap) */
+#ifndef STREAM_PARSE_BUFFER_SIZE
+#define STREAM_PARSE_BUFFER_SIZE 65536
+#endif
+
 #include "cryptoconnect/helpers/utils/datetime.hpp"
 #include "cryptoconnect/structs/events.hpp"
 #include "cryptoconnect/structs/event_queue.hpp"
 
 #include <rapidjson/document.h>
 
+#include <functional>
+#include <span>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 namespace CryptoConnect::CoinbasePro::Stream
 {
-    using document_t = rapidjson::Document;
+    using allocator_t = rapidjson::MemoryPoolAllocator<>;
+    using document_t = rapidjson::GenericDocument<rapidjson::UTF8<>, allocator_t, allocator_t>;
+
+    /* Called with the product ID whenever a product's book is (re)built from a snapshot */
+    using snapshotCallback_t = std::function<void(std::string const &)>;
 
     class Handler
     {
     private:
         Events::Queue *eventQueue_;
+        snapshotCallback_t snapshotCallback_;
+
+        /* Memory reused by the parser across messages (values and parsing stack) */
+        std::vector<char> valueBuffer_;
+        std::vector<char> stackBuffer_;
+        allocator_t valueAllocator_;
+        allocator_t stackAllocator_;
 
         /**
          * We need to track the snapshots and previous ticks for each security
@@ -31,9 +50,13 @@ namespace CryptoConnect::CoinbasePro::Stream
 
     public:
         /* Constructor */
-        Handler(Events::Queue *eventQueue) : eventQueue_(eventQueue){};
+        Handler(Events::Queue *eventQueue);
+
+        /* Registers the callback for rebuilt books (set before any message is handled) */
+        void setSnapshotCallback(snapshotCallback_t callback);
 
-        void onMessage(std::string const &message);
+        /* Parses the NUL-terminated message in situ (the message is clobbered) */
+        void onMessage(std::span<char> message);
 
     private:
         void handleSnapshot(document_t &document);
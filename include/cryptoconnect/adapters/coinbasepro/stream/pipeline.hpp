@@ -0,0 +1,111 @@
+#ifndef CRYPTOCONNECT_COINBASEPRO_STREAM_PIPELINE_H
+#define CRYPTOCONNECT_COINBASEPRO_STREAM_PIPELINE_H
+
+/* Number of threads parsing the stream (override with -DSTREAM_PARSER_THREADS=n) */
+#ifndef STREAM_PARSER_THREADS
+#define STREAM_PARSER_THREADS 2
+#endif
+
+/* Number of raw frames each reader can have pending per parser thread (power of 2) */
+#ifndef STREAM_RING_CAPACITY
+#define STREAM_RING_CAPACITY 256
+#endif
+
+/* Frames parsed from one reader's ring before moving on to the next reader's */
+#ifndef STREAM_PARSE_BATCH
+#define STREAM_PARSE_BATCH 64
+#endif
+
+/* Microseconds a reader waits for its parser to free up a slot before retrying (the io thread serves others meanwhile) */
+#ifndef STREAM_RING_RETRY_US
+#define STREAM_RING_RETRY_US 50
+#endif
+
+#include "cryptoconnect/helpers/network/websockets/client.hpp"
+#include "cryptoconnect/helpers/utils/ring_buffer.hpp"
+#include "cryptoconnect/structs/event_queue.hpp"
+#include "./handler.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace CryptoConnect::CoinbasePro::Stream
+{
+    /**
+     * Raw frame read in place, with the view into its buffer
+     *
+     * Every frame (the readers' and the rings' slots) preallocates a
+     * buffer for the largest snapshot, so the buffers swapped between
+     * them are interchangeable and never grown per frame. The pages are
+     * only committed as frames are read into them.
+     */
+    struct Frame
+    {
+        beast::flat_buffer buffer_;
+        std::span<char> data_;
+
+        Frame() { this->buffer_.reserve(WEBSOCKETS_READ_BUFFER_SIZE); }
+    };
+
+    /**
+     * Decouples reading the sockets from parsing the messages
+     *
+     * Readers hand raw frames over to a pool of parser threads
+     * through lock-free rings (one per reader and parser pair).
+     * Frames are routed by product ID so that each product is always
+     * parsed by the same thread, preserving the order of its messages
+     * and keeping its book state single-writer.
+     */
+    class Pipeline
+    {
+    private:
+        using ring_t = Utils::Concurrency::RingBuffer<Frame>;
+
+        struct Worker
+        {
+            Handler handler_;
+
+            /* One ring per reader to keep each of them single-producer */
+            std::vector<std::unique_ptr<ring_t>> rings_;
+
+            /* Bumped by the readers on every publish for the worker to sleep on */
+            std::atomic<uint64_t> signal_{0};
+
+            Worker(Events::Queue *eventQueue, size_t numReaders) : handler_(eventQueue)
+            {
+                for (size_t i = 0; i < numReaders; i++)
+                    this->rings_.push_back(std::make_unique<ring_t>(STREAM_RING_CAPACITY));
+            }
+        };
+
+        std::vector<std::unique_ptr<Worker>> workers_;
+
+    public:
+        /* Constructor */
+        Pipeline(Events::Queue *eventQueue, size_t numReaders = 1,
+                 size_t numWorkers = STREAM_PARSER_THREADS);
+
+        /* Registers the callback for rebuilt books on every parser (set before starting) */
+        void setSnapshotCallback(snapshotCallback_t callback);
+
+        /* Spawns the parser threads */
+        void start();
+
+        /* Hands a reader's raw frame over to its parser unless its ring is full (swapped for the slot's spent buffer) */
+        bool tryDispatch(size_t reader, Frame &frame);
+
+    private:
+        /* Picks the worker responsible for the frame's product */
+        size_t route(std::span<char const> frame) const;
+
+        /* Loops and parses the frames routed to the worker */
+        void parseForever(Worker &worker);
+    };
+}
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef NETWORK_DNS_CACHE_H
+#define NETWORK_DNS_CACHE_H
+
+/* Age after which resolved addresses are refreshed in the background (still served until then) */
+#ifndef DNS_CACHE_TTL_S
+#define DNS_CACHE_TTL_S 30
+#endif
+
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/awaitable.hpp> // after a header bringing in <utility>
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Network::DNS
+{
+    using tcp = boost::asio::ip::tcp;
+    using endpoints_t = std::vector<tcp::endpoint>;
+
+    /**
+     * Resolver cache shared by every connection
+     *
+     * Only the first lookup of a host waits on the resolver: the
+     * addresses are then served from the cache while a background
+     * thread refreshes them past their TTL (keeping the old ones if
+     * the refresh fails). Connections try the addresses in order and
+     * report the one that worked so that dead ones are skipped next.
+     */
+    class Cache
+    {
+    private:
+        struct Entry
+        {
+            std::string host_;
+            std::string port_;
+            endpoints_t endpoints_;
+            std::chrono::steady_clock::time_point resolveTime_;
+        };
+
+        /* Keyed by host:port */
+        std::unordered_map<std::string, Entry> entries_;
+        std::mutex mutex_;
+
+    public:
+        /* Cache shared by the process (its refreshing thread is started on first use) */
+        static Cache &shared();
+
+        /* Addresses of the host (resolved on the spot only if never resolved before) */
+        endpoints_t resolve(std::string const &host, std::string const &port);
+
+        /* Addresses of the host (only awaits the resolver if never resolved before, never blocks the thread) */
+        boost::asio::awaitable<endpoints_t> asyncResolve(std::string const &host, std::string const &port);
+
+        /* Addresses of the host if already resolved (never resolves) */
+        bool find(std::string const &host, std::string const &port, endpoints_t &output);
+
+        /* Moves the address a connection succeeded on to the front */
+        void promote(std::string const &host, std::string const &port, tcp::endpoint const &endpoint);
+
+    private:
+        /* Constructor */
+        Cache(){};
+
+        /* Caches freshly resolved addresses */
+        void store(std::string const &host, std::string const &port, endpoints_t const &endpoints);
+
+        /* Resolves the host synchronously */
+        static endpoints_t lookup(std::string const &host, std::string const &port);
+
+        /* Loops and refreshes the entries past their TTL */
+        void refreshForever();
+    };
+}
+
+#endif
@@ -0,0 +1,164 @@
+#ifndef NETWORK_HTTP_ASYNCSESSION_H
+#define NETWORK_HTTP_ASYNCSESSION_H
+
+#include "./rate_limiter.hpp"
+#include "./session.hpp"
+#include "cryptoconnect/helpers/network/tls/context.hpp"
+
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+#include <boost/beast/ssl.hpp>
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/strand.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Network::HTTP
+{
+    /**
+     * Asynchronous HTTPS session over a pool of keep-alive connections
+     *
+     * Runs on an io_context driven by the owner's threads, so a handful
+     * of threads can keep many requests in flight (one per connection,
+     * up to maxConnections, the others waiting for a connection to
+     * free up). Requests are available as coroutines or with any asio
+     * completion token: a callback taking (std::exception_ptr,
+     * std::string), net::use_future or net::use_awaitable.
+     */
+    class AsyncSession
+    {
+    private:
+        struct Connection
+        {
+            beast::ssl_stream<beast::tcp_stream> stream_;
+            beast::flat_buffer buffer_;
+            bool isReusable_{false}; // Whether the last response kept it alive
+            std::chrono::steady_clock::time_point lastUsed_; // When it was last kept idle
+
+            Connection(net::io_context &ioc, ssl::context &ctx) : stream_(ioc, ctx){};
+        };
+
+        /* Request waiting for a connection (handed one, or a free slot to open one in if left empty) */
+        struct Waiter
+        {
+            net::steady_timer timer_;
+            std::unique_ptr<Connection> connection_;
+            std::atomic<bool> isReady_{false}; // Set (release) once connection_ is handed over, read off the lock
+
+            Waiter(net::any_io_executor executor) : timer_(executor){};
+        };
+
+        net::io_context &ioc_;
+        TLS::Context &tls_; // Shared with every connection to the host
+        std::string host_;
+        std::string port_;
+
+        /* Custom headers and decorators - direct headers override decorator-added headers */
+        headers_t headers_;
+        requestDecorators_t requestDecorators_;
+
+        /* Connections open or being opened, idle ones and requests waiting for one */
+        size_t maxConnections_;
+        size_t numConnections_{0};
+        std::vector<std::unique_ptr<Connection>> idleConnections_; // Most recently used at the back
+        std::deque<std::shared_ptr<Waiter>> waiters_;
+        std::mutex mutex_;
+
+    public:
+        /* Constructor (connections are opened on demand) */
+        AsyncSession(net::io_context &ioc, char const *host, char const *port, size_t maxConnections);
+
+        /* Add headers into subsequent requests */
+        void addHeaders(const headers_t headers);
+
+        /* Add a decorator to apply onto subsequent requests */
+        void addRequestDecorator(requestDecorator_t decorator);
+
+        /* Opens numConnections connections upfront and pings the target on the ones left idle for an interval (metered at low priority if given a limiter) */
+        void keepWarm(size_t numConnections, std::chrono::seconds interval, std::string pingTarget,
+                      RateLimiter *limiter = nullptr);
+
+        /* Coroutine request (idempotent ones are retried once if their reused connection was stale) */
+        net::awaitable<std::string> request(http::verb method, std::string target, std::string body = "");
+
+        /* Coroutine request returning the whole response (for its headers) */
+        net::awaitable<response_t> exchange(http::verb method, std::string target, std::string body = "");
+
+        /**
+         * Request Methods (any completion token)
+         *
+         * Each request runs on its own strand of the io_context.
+         */
+
+        /* HTTP GET Request */
+        template <typename CompletionToken>
+        auto asyncGet(std::string target, CompletionToken &&token)
+        {
+            return net::co_spawn(
+                net::make_strand(this->ioc_),
+                this->perform(http::verb::get, std::move(target), ""),
+                std::forward<CompletionToken>(token));
+        }
+
+        /* HTTP POST Request (never retried) */
+        template <typename CompletionToken>
+        auto asyncPost(std::string target, std::string body, CompletionToken &&token)
+        {
+            return net::co_spawn(
+                net::make_strand(this->ioc_),
+                this->perform(http::verb::post, std::move(target), std::move(body)),
+                std::forward<CompletionToken>(token));
+        }
+
+        /* HTTP DELETE Request */
+        template <typename CompletionToken>
+        auto asyncDel(std::string target, CompletionToken &&token)
+        {
+            return net::co_spawn(
+                net::make_strand(this->ioc_),
+                this->perform(http::verb::delete_, std::move(target), ""),
+                std::forward<CompletionToken>(token));
+        }
+
+    private:
+        /* Reopens the missing connections and pings the stale idle ones one at a time at every interval */
+        net::awaitable<void> maintainWarm(size_t numConnections, std::chrono::seconds interval, std::string pingTarget,
+                                          RateLimiter *limiter);
+
+        /* Takes the least recently used idle connection if it has been idle since before staleBefore */
+        std::unique_ptr<Connection> takeStale(std::chrono::steady_clock::time_point staleBefore);
+
+        /* Opens a connection in a slot reserved for it and keeps it idle (the slot is freed if it fails) */
+        net::awaitable<void> openIdle();
+
+        /* Performs the request (on a strand) */
+        net::awaitable<std::string> perform(http::verb method, std::string target, std::string body);
+
+        /* Performs the request for its whole response (on a strand) */
+        net::awaitable<response_t> transact(http::verb method, std::string target, std::string body);
+
+        /* Takes an idle connection, or waits for one if they are all busy (nullptr to open one) */
+        net::awaitable<std::unique_ptr<Connection>> acquire(bool &isReused);
+
+        /* Hands the connection over to a waiting request or keeps it idle (nullptr frees its slot) */
+        void release(std::unique_ptr<Connection> connection);
+
+        /* Opens a new connection */
+        net::awaitable<std::unique_ptr<Connection>> connect();
+
+        /* Sends the request on the connection and reads the response */
+        net::awaitable<response_t> send(Connection &connection, request_t &req);
+    };
+}
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef NETWORK_HTTP_RATELIMITER_H
+#define NETWORK_HTTP_RATELIMITER_H
+
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/awaitable.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace Network::HTTP
+{
+    /* Order in which throttled requests get through (e.g. orders and cancels ahead of bars and history) */
+    enum class Priority : uint8_t
+    {
+        HIGH = 0,
+        NORMAL = 1,
+        LOW = 2
+    };
+
+    /* Time spent throttled by an endpoint's requests */
+    struct ThrottleStats
+    {
+        uint64_t requests_{0};
+        uint64_t throttled_{0};          // Requests that had to wait
+        uint64_t waitNanoseconds_{0};    // Total time waited
+        uint64_t maxWaitNanoseconds_{0}; // Longest single wait
+    };
+
+    using throttleStats_t = std::unordered_map<std::string, ThrottleStats>;
+
+    /**
+     * Lock-free token bucket shared by every request to a rate-limited host
+     *
+     * Tracked as the time at which the bucket would be full again
+     * (GCRA), updated with a single compare-and-swap. Requests that
+     * would overdraw the bucket wait for their token instead of being
+     * rejected. High priority requests reserve their token straight
+     * away and wait in line for it, while the lower priorities only
+     * take a token that is available now (retrying later otherwise)
+     * and leave part of the burst for the priorities above them.
+     */
+    class RateLimiter
+    {
+    private:
+        int64_t interval_;                        // Nanoseconds between tokens
+        int64_t tolerances_[3];                   // Burst each priority can draw on (nanoseconds ahead of now)
+        std::atomic<int64_t> theoreticalTime_{0}; // When the next token is due at the sustained rate
+
+        /* Only the counters are locked */
+        throttleStats_t stats_;
+        std::mutex statsMutex_;
+
+    public:
+        /* Constructor */
+        RateLimiter(double ratePerSecond, size_t burst);
+
+        /* Blocks until the request can be sent */
+        void acquire(Priority priority, std::string const &endpoint);
+
+        /* Awaits until the request can be sent */
+        boost::asio::awaitable<void> asyncAcquire(Priority priority, std::string endpoint);
+
+        /* Reads the per-endpoint counters */
+        void getStats(throttleStats_t &output);
+
+    private:
+        /* Takes a token (returning how long to wait for it) or returns how long to wait before trying again */
+        int64_t reserve(Priority priority, bool &isReserved);
+
+        /* Records the wait of an endpoint's request */
+        void record(std::string const &endpoint, int64_t waitNanoseconds);
+    };
+}
+
+#endif
@@ -0,0 +1,176 @@
+#ifndef NETWORK_HTTP_RETRYPOLICY_H
+#define NETWORK_HTTP_RETRYPOLICY_H
+
+#include "./session.hpp"
+
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/awaitable.hpp> // after a header bringing in <utility>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace Network::HTTP
+{
+    /**
+     * When and how long to wait before retrying a failed request
+     *
+     * Rate-limited (429) requests were not acted upon and are always
+     * retried. Server errors (5xx) and socket errors are only retried
+     * for idempotent requests since the host may have acted on them.
+     */
+    struct RetryPolicy
+    {
+        size_t maxAttempts_;                      // Including the first one
+        std::chrono::milliseconds baseBackoff_;   // Backoff cap of the first retry, doubled on every retry
+        std::chrono::milliseconds maxBackoff_;    // Backoff cap of the later retries
+        std::chrono::milliseconds hedgeAfter_{0}; // Latency after which idempotent requests are hedged (0 to disable)
+
+        /* Whether the request that failed with the exception should be retried */
+        bool isRetryable(std::exception const &e, bool isIdempotent) const;
+
+        /* Random wait before the given retry (full jitter under the exponential cap) */
+        std::chrono::nanoseconds backoff(size_t retry) const;
+    };
+
+    /* Performs the request, retrying it with backoff as the policy allows */
+    template <typename Request>
+    void withRetries(RetryPolicy const &policy, bool isIdempotent, Request request)
+    {
+        for (size_t attempt = 1;; attempt++)
+        {
+            try
+            {
+                request();
+                return;
+            }
+            catch (std::exception const &e)
+            {
+                if (attempt >= policy.maxAttempts_ || !policy.isRetryable(e, isIdempotent))
+                    throw;
+            }
+
+            std::this_thread::sleep_for(policy.backoff(attempt));
+        }
+    }
+
+    /* Awaits the request (a callable returning an awaitable), retrying it with backoff as the policy allows */
+    template <typename Request>
+    std::invoke_result_t<Request &> asyncWithRetries(RetryPolicy const &policy, bool isIdempotent, Request request)
+    {
+        net::steady_timer timer(co_await net::this_coro::executor);
+
+        for (size_t attempt = 1;; attempt++)
+        {
+            try
+            {
+                co_return co_await request();
+            }
+            catch (std::exception const &e)
+            {
+                if (attempt >= policy.maxAttempts_ || !policy.isRetryable(e, isIdempotent))
+                    throw;
+            }
+
+            timer.expires_after(policy.backoff(attempt));
+            co_await timer.async_wait(net::use_awaitable);
+        }
+    }
+
+    /**
+     * Awaits an idempotent request, racing a second attempt against it
+     * once it has been outstanding for longer than the policy's hedging
+     * latency. The first success wins (the slower attempt runs to
+     * completion in the background), a failure only once both failed.
+     *
+     * Each attempt awaits its own token from the rate limiter (acquire)
+     * before it is sent (request). The latency is only timed from when
+     * the first attempt has its token, so time spent throttled never
+     * triggers a hedge, and the hedge never takes the first one's token.
+     *
+     * Awaited on a strand, which the attempts complete on.
+     */
+    template <typename Acquire, typename Request>
+    net::awaitable<std::string> hedged(RetryPolicy const &policy, Acquire acquire, Request request)
+    {
+        co_await acquire();
+
+        // Guard clause for hedging being disabled
+        if (policy.hedgeAfter_.count() <= 0)
+            co_return co_await request();
+
+        struct Race
+        {
+            net::steady_timer timer_;
+            size_t numPending_{0};
+            bool isDone_{false};
+            std::string output_;
+            std::exception_ptr failure_;
+
+            Race(net::any_io_executor executor) : timer_(executor){};
+        };
+
+        auto executor = co_await net::this_coro::executor;
+        auto race = std::make_shared<Race>(executor);
+
+        auto launch = [&](net::awaitable<std::string> attempt)
+        {
+            race->numPending_++;
+            net::co_spawn(
+                executor,
+                std::move(attempt),
+                [race](std::exception_ptr failure, std::string output)
+                {
+                    race->numPending_--;
+                    if (race->isDone_)
+                        return;
+
+                    if (!failure)
+                        race->output_ = std::move(output);
+                    race->failure_ = failure;
+
+                    // Only give up on a failure once no other attempt is pending
+                    if (!failure || !race->numPending_)
+                    {
+                        race->isDone_ = true;
+                        race->timer_.cancel();
+                    }
+                });
+        };
+
+        // Woken up early by the completion cancelling the timer (on our strand, so never before the wait starts)
+        boost::system::error_code ec;
+        race->timer_.expires_after(policy.hedgeAfter_);
+        launch(request());
+        co_await race->timer_.async_wait(net::redirect_error(net::use_awaitable, ec));
+
+        // Hedge a straggler (throttled on a token of its own)
+        if (!race->isDone_)
+            launch([](Acquire acquire, Request request) -> net::awaitable<std::string>
+                   {
+                       co_await acquire();
+                       co_return co_await request();
+                   }(acquire, request));
+
+        while (!race->isDone_)
+        {
+            race->timer_.expires_at(net::steady_timer::time_point::max());
+            co_await race->timer_.async_wait(net::redirect_error(net::use_awaitable, ec));
+        }
+
+        if (race->failure_)
+            std::rethrow_exception(race->failure_);
+        co_return std::move(race->output_);
+    }
+}
+
+#endif
@@ -8,8 +8,14 @@
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/ssl/stream.hpp>
 
+#include "cryptoconnect/helpers/network/dns/cache.hpp"
+#include "cryptoconnect/helpers/network/tls/context.hpp"
+
 #include <functional>
+#include <span>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -22,23 +28,52 @@ using tcp = net::ip::tcp;       // from <boost/asio/ip/tcp.hpp>
 namespace Network::HTTP
 {
     using request_t = http::request<http::string_body>;
+    using response_t = http::response<http::string_body>;
     using headers_t = std::unordered_map<char const *, char const *>;
     using requestDecorator_t = std::function<void(request_t &)>;
     using requestDecorators_t = std::vector<requestDecorator_t>;
 
+    /* Handed the response body in place (mutable and NUL-terminated, only valid during the call) */
+    using responseHandler_t = std::function<void(std::span<char>)>;
+
+    /* Thrown for responses worth retrying (429 and 5xx), the connection is left usable */
+    class StatusError : public std::runtime_error
+    {
+    private:
+        unsigned status_;
+
+    public:
+        StatusError(unsigned status, std::string const &reason)
+            : std::runtime_error("HTTP " + std::to_string(status) + " " + reason), status_(status){};
+
+        unsigned getStatus() const { return this->status_; }
+
+        /* Whether the status is one that should be retried */
+        static bool isRetryable(unsigned status) { return status == 429 || status >= 500; }
+    };
+
+    /**
+     * Keep-alive HTTPS session on a single connection
+     *
+     * Not thread-safe: share sessions across threads
+     * through a SessionPool instead.
+     */
     class Session
     {
     private:
         net::io_context ioc_;
-        ssl::context ctx_{ssl::context::tlsv13_client};
-        tcp::resolver resolver_{this->ioc_};
-        beast::ssl_stream<beast::tcp_stream> stream_{this->ioc_, this->ctx_};
+        TLS::Context &tls_; // Shared with every connection to the host
+        beast::ssl_stream<beast::tcp_stream> stream_{this->ioc_, this->tls_.getContext()};
+        /* Receive buffer and response body reused across the connection's requests */
         beast::flat_buffer buffer_;
+        std::string body_;
 
-        /* Tracked for creating separate sessions */
         char const *host_;
         char const *port_;
 
+        /* Whether the connection can take another request (the last response kept it alive) */
+        bool isReusable_{true};
+
         /* Custom headers and decorators - direct headers override decorator-added headers */
         headers_t headers_;
         requestDecorators_t requestDecorators_;
@@ -74,32 +109,32 @@ namespace Network::HTTP
         void del(char const *target, std::string &output);
 
         /**
-         * Isolated Request Methods
-         * 
-         * Creates a separate session instance
-         * to facilitate multithreading
-         * albeit slightly slower.
+         * Zero-copy Request Methods
+         *
+         * The body is exposed in place as a mutable and NUL-terminated span
+         * (suitable for in-situ parsing) that stays valid until the
+         * session's next request.
          */
 
-        /* HTTP GET Request in a separate session - facilitates multithreading */
-        void isolatedGet(char const *target, std::string &output);
+        /* HTTP GET Request */
+        std::span<char> get(char const *target);
+
+        /* HTTP POST Request */
+        std::span<char> post(char const *target, std::string_view body);
 
-        /* HTTP POST Request in a separate session - facilitates multithreading */
-        void isolatedPost(char const *target, std::string &output);
+        /* HTTP Delete Request */
+        std::span<char> del(char const *target);
 
-        /* HTTP DELETE Request in a separate session - facilitates multithreading */
-        void isolatedDel(char const *target, std::string &output);
+        /* Whether the idle connection is still open and can take another request */
+        bool isHealthy();
 
     private:
-        /* Private constructor to replicate a session for isolated requests */
-        Session(Session *session);
-
         /* Called by constuctors to initialize the session */
         void initSession();
 
-        /* Called by request methods to perform the request */
-        void request(http::request<http::string_body> &req, std::string &output);
+        /* Called by request methods to perform the request (body read into the session's buffer) */
+        std::span<char> request(request_t &req);
     };
 }
 
-#endif
\ No newline at end of file
+#endif
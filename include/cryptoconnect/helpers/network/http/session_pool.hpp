@@ -0,0 +1,153 @@
+#ifndef NETWORK_HTTP_SESSIONPOOL_H
+#define NETWORK_HTTP_SESSIONPOOL_H
+
+/* Idle sessions kept open per pool (extra ones are closed when returned) */
+#ifndef HTTP_POOL_MAX_IDLE
+#define HTTP_POOL_MAX_IDLE 8
+#endif
+
+#include "./rate_limiter.hpp"
+#include "./session.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace Network::HTTP
+{
+    /* Counters for telling warm requests apart from the ones paying for a handshake */
+    struct PoolStats
+    {
+        uint64_t connects_; // Sessions opened (DNS, TCP and TLS handshakes)
+        uint64_t reuses_;   // Requests served on an already open session
+        uint64_t retries_;  // Requests replayed on a fresh session after their stale one failed
+        uint64_t drops_;    // Sessions closed after failing a health check or a ping
+    };
+
+    /**
+     * Thread-safe pool of warm keep-alive sessions to a host
+     *
+     * Requests check a session out (the most recently used first),
+     * reuse its open connection and return it. Stale connections are
+     * detected on checkout and idempotent requests failing on a reused
+     * connection are transparently retried once on a fresh one.
+     */
+    class SessionPool
+    {
+    private:
+        struct IdleSession
+        {
+            std::unique_ptr<Session> session_;
+            std::chrono::steady_clock::time_point lastUsed_;
+        };
+
+        char const *host_;
+        char const *port_;
+        size_t maxIdle_;
+
+        /* Applied to every session opened */
+        headers_t headers_;
+        requestDecorators_t requestDecorators_;
+
+        /* Most recently used sessions at the back */
+        std::deque<IdleSession> idleSessions_;
+        std::mutex mutex_;
+
+        /* Counters */
+        std::atomic<uint64_t> connects_{0};
+        std::atomic<uint64_t> reuses_{0};
+        std::atomic<uint64_t> retries_{0};
+        std::atomic<uint64_t> drops_{0};
+
+    public:
+        /* Session checked out of the pool, returned to it on destruction */
+        class Lease
+        {
+        private:
+            SessionPool *pool_;
+            std::unique_ptr<Session> session_;
+            bool isReused_;
+
+        public:
+            Lease(SessionPool *pool, std::unique_ptr<Session> session, bool isReused)
+                : pool_(pool), session_(std::move(session)), isReused_(isReused){};
+            Lease(Lease &&lease) = default;
+            ~Lease();
+
+            Session *operator->() { return this->session_.get(); }
+            Session &operator*() { return *this->session_; }
+
+            /* Whether the session had already served requests before this lease */
+            bool isReused() const { return this->isReused_; }
+
+            /* Closes the session instead of returning it */
+            void discard() { this->session_.reset(); }
+        };
+
+        /* Constructor (sessions are only opened on demand or when warming up) */
+        SessionPool(char const *host, char const *port, size_t maxIdle = HTTP_POOL_MAX_IDLE);
+
+        /* Add headers into the requests of every session */
+        void addHeaders(const headers_t headers);
+
+        /* Add a decorator to apply onto the requests of every session */
+        void addRequestDecorator(requestDecorator_t decorator);
+
+        /* Opens sessions until there are at least numSessions idle ones */
+        void warmUp(size_t numSessions);
+
+        /* Health-checks the idle sessions on a timer, pinging the target on the ones idle for longer (thread-safe, metered at low priority if given a limiter) */
+        void keepAlive(std::chrono::seconds interval, std::string const pingTarget, size_t minIdle = 1,
+                       RateLimiter *limiter = nullptr);
+
+        /* Checks out a healthy idle session or opens a new one */
+        Lease checkout();
+
+        /* Reads the counters */
+        void getStats(PoolStats &output);
+
+        /* Request Methods (same as the session's, thread-safe) */
+
+        /* HTTP GET Request (retried once if its reused connection was stale) */
+        void get(char const *target, std::string &output);
+
+        /* HTTP POST Request (never retried) */
+        void post(char const *target, std::string &output, const std::string &body = "");
+
+        /* HTTP Delete Request (retried once if its reused connection was stale) */
+        void del(char const *target, std::string &output);
+
+        /* Zero-copy Request Methods (the body is handed over in place while the session is still checked out) */
+
+        /* HTTP GET Request (retried once if its reused connection was stale) */
+        void get(char const *target, responseHandler_t const &handler);
+
+        /* HTTP POST Request (never retried) */
+        void post(char const *target, std::string_view body, responseHandler_t const &handler);
+
+        /* HTTP Delete Request (retried once if its reused connection was stale) */
+        void del(char const *target, responseHandler_t const &handler);
+
+    private:
+        /* Opens a new session with the pool's headers and decorators */
+        std::unique_ptr<Session> makeSession();
+
+        /* Returns a session to the idle ones (closing it if unusable or in excess) */
+        void checkin(std::unique_ptr<Session> session);
+
+        /* Performs an idempotent request, retrying once on a fresh session if a reused one failed */
+        template <typename Request>
+        void requestIdempotent(Request request);
+
+        /* Health-checks and pings the idle sessions */
+        void maintainIdle(std::chrono::seconds interval, std::string const &pingTarget, size_t minIdle,
+                          RateLimiter *limiter);
+    };
+}
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef NETWORK_TLS_CONTEXT_H
+#define NETWORK_TLS_CONTEXT_H
+
+/* TLS 1.3 suites in order of preference (AES-GCM first as it is hardware-accelerated on AES-NI/ARMv8 CPUs) */
+#ifndef TLS_CIPHERSUITES
+#define TLS_CIPHERSUITES "TLS_AES_128_GCM_SHA256:TLS_AES_256_GCM_SHA384:TLS_CHACHA20_POLY1305_SHA256"
+#endif
+
+#include <boost/asio/ssl/context.hpp>
+
+#include <openssl/ssl.h>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace ssl = boost::asio::ssl; // from <boost/asio/ssl.hpp>
+
+namespace Network::TLS
+{
+    /* Counters for the handshakes done with the context */
+    struct Stats
+    {
+        uint64_t handshakes_;
+        uint64_t resumptions_; // Handshakes that resumed a cached session (hit rate = resumptions / handshakes)
+    };
+
+    /**
+     * TLS client context shared by every connection to an endpoint
+     *
+     * Verifies the peer's certificate and host name, prefers AES-GCM
+     * and caches the session tickets handed out by the endpoint so
+     * that new connections resume a session instead of going through
+     * a full handshake.
+     */
+    class Context
+    {
+    private:
+        ssl::context ctx_{ssl::context::tlsv13_client};
+
+        /* Latest session ticket received from each host */
+        std::unordered_map<std::string, SSL_SESSION *> sessions_;
+        std::mutex sessionsMutex_;
+
+        /* Counters */
+        std::atomic<uint64_t> handshakes_{0};
+        std::atomic<uint64_t> resumptions_{0};
+
+    public:
+        /* Constructor */
+        Context();
+
+        /* Destructor (frees the cached sessions) */
+        ~Context();
+
+        Context(Context const &) = delete;
+        Context &operator=(Context const &) = delete;
+
+        /* Context shared by all the connections to the host (created on first use, lives for the process) */
+        static Context &shared(std::string const &host);
+
+        ssl::context &getContext();
+
+        /* Sets up a connection before its handshake (SNI, host name verification and session to resume) */
+        void prepare(SSL *ssl, std::string const &host);
+
+        /* Records a completed handshake */
+        void onHandshake(SSL *ssl);
+
+        /* Reads the counters */
+        void getStats(Stats &output);
+
+    private:
+        /* Called by OpenSSL with every new session ticket */
+        static int onNewSession(SSL *ssl, SSL_SESSION *session);
+    };
+}
+
+#endif
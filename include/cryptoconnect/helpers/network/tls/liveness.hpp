@@ -0,0 +1,50 @@
+#ifndef NETWORK_TLS_LIVENESS_H
+#define NETWORK_TLS_LIVENESS_H
+
+#include <boost/beast/core.hpp>
+#include <boost/beast/ssl.hpp>
+#include <boost/asio/error.hpp>
+
+#include <poll.h>
+
+namespace beast = boost::beast; // from <boost/beast.hpp>
+namespace net = boost::asio;    // from <boost/asio.hpp>
+
+namespace Network::TLS
+{
+    /**
+     * Whether an idle connection can still take a request
+     *
+     * Bytes waiting on an idle socket are not necessarily the host
+     * closing it: TLS 1.3 hosts send their session tickets after the
+     * handshake. Whatever arrived is read through TLS without blocking,
+     * which consumes such records, and only the end of the stream, an
+     * alert or unexpected data mean the connection is done.
+     */
+    inline bool isIdleOpen(beast::ssl_stream<beast::tcp_stream> &stream)
+    {
+        auto &socket = beast::get_lowest_layer(stream).socket();
+        if (!socket.is_open())
+            return false;
+
+        // Guard clause for the usual case of nothing having arrived
+        pollfd fd{socket.native_handle(), POLLIN, 0};
+        if (::poll(&fd, 1, 0) == 0)
+            return true;
+
+        boost::system::error_code ec;
+        socket.non_blocking(true, ec);
+        if (ec)
+            return false;
+
+        // Running out of bytes before any application data means only post-handshake records were pending
+        char byte;
+        stream.read_some(net::buffer(&byte, 1), ec);
+        bool const isOpen = ec == net::error::would_block;
+
+        socket.non_blocking(false, ec);
+        return isOpen && !ec;
+    }
+}
+
+#endif
@@ -1,12 +1,33 @@
 #ifndef NETWORK_WEBSOCKETS_CLIENT_H
 #define NETWORK_WEBSOCKETS_CLIENT_H
 
+/* Bytes preallocated for every frame buffer readers read into (sized for the largest expected snapshot) */
+#ifndef WEBSOCKETS_READ_BUFFER_SIZE
+#define WEBSOCKETS_READ_BUFFER_SIZE 4194304
+#endif
+
+/* Define WEBSOCKETS_PROFILE_READS to time every read (decryption, framing and inflating) in thread CPU */
+
 #include <boost/beast/core.hpp>
 #include <boost/beast/ssl.hpp>
 #include <boost/beast/websocket.hpp>
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/io_context.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/ssl/stream.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/strand.hpp>
+
+#include "cryptoconnect/helpers/network/dns/cache.hpp"
+#include "cryptoconnect/helpers/network/tls/context.hpp"
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <span>
 #include <string>
 
 namespace beast = boost::beast;         // from <boost/beast.hpp>
@@ -20,31 +41,123 @@ namespace Network::WebSockets
 {
     using request_t = websocket::request_type;
 
+    /**
+     * permessage-deflate settings (RFC 7692)
+     *
+     * Window bits (9-15) trade the memory and CPU spent on the
+     * sliding window against the compression ratio achieved.
+     */
+    struct Compression
+    {
+        bool isEnabled_;
+        int serverMaxWindowBits_; // Window the server compresses our inbound frames with
+        int clientMaxWindowBits_; // Window we compress our outbound frames with
+
+        Compression(bool isEnabled = false, int serverMaxWindowBits = 15, int clientMaxWindowBits = 15)
+            : isEnabled_(isEnabled), serverMaxWindowBits_(serverMaxWindowBits),
+              clientMaxWindowBits_(clientMaxWindowBits){};
+    };
+
+    /* Counters for comparing bytes on the wire against the cost of reading them */
+    struct Stats
+    {
+        uint64_t frames_;
+        uint64_t payloadBytes_;       // Bytes after decompression
+        uint64_t wireBytes_;          // TLS bytes received from the socket
+        uint64_t readCpuNanoseconds_; // Thread CPU time spent in reads (only with WEBSOCKETS_PROFILE_READS)
+        uint64_t ioCpuNanoseconds_;   // CPU time of the threads driving the reads (filled in by their owner)
+        bool isCompressed_;           // permessage-deflate agreed by the host on the current connection
+    };
+
+    using strand_t = net::strand<net::io_context::executor_type>;
+    using stream_t = websocket::stream<beast::ssl_stream<beast::tcp_stream>>;
+
+    /**
+     * Asynchronous websocket client
+     *
+     * Every operation on the stream runs on the client's strand, so a
+     * single io_context (driven by one or more threads) can serve many
+     * clients. Reads are awaited by a single reading coroutine, writes
+     * are queued from any thread and pings are driven by a timer.
+     */
     class Client
     {
     private:
-        net::io_context ioc_;
-        ssl::context ctx_{ssl::context::tlsv13_client};
-        tcp::resolver resolver_{this->ioc_};
-        websocket::stream<beast::ssl_stream<tcp::socket>> ws_{this->ioc_, this->ctx_};
-        beast::flat_buffer buffer_;
-        const char *host_;
+        net::io_context &ioc_;
+        strand_t strand_;
+        TLS::Context *tls_{nullptr}; // Shared with every connection to the host (set on connect)
+
+        /* Recreated on every connect since a failed stream cannot be reused (shared with pending operations) */
+        std::shared_ptr<stream_t> ws_;
+
+        /* Only guards the stream pointer for readers off the strand (stats) */
+        std::mutex mutex_;
+
+        /* Tracked for reconnecting */
+        std::string host_;
+        std::string port_;
+        std::string target_;
+
+        /* Outbound messages waiting to be written (strand only) */
+        std::deque<std::string> writeQueue_;
+        bool isWriting_{false};
+        bool isConnected_{false};
+
+        /* Keepalive */
+        net::steady_timer pingTimer_{this->strand_};
+
+        /* Offered on connect, and whether the host agreed to it */
+        Compression compression_;
+        std::atomic<bool> isCompressed_{false};
+
+        /* Read counters */
+        std::atomic<uint64_t> frames_{0};
+        std::atomic<uint64_t> payloadBytes_{0};
+        std::atomic<uint64_t> readCpuNanoseconds_{0};
+        std::atomic<uint64_t> previousWireBytes_{0}; // From the streams replaced by reconnects
 
     public:
-        /* Connector to initialize the context */
-        void connect(const char *host, const char *port, const char *target = "/");
+        /* Constructor (the io_context is run by the owner) */
+        Client(net::io_context &ioc);
+
+        /* Strand all of the client's operations run on (coroutines using the client are spawned on it) */
+        strand_t &getStrand();
+
+        /* Sets the compression to offer on subsequent connects */
+        void setCompression(Compression const &compression);
 
-        /* Pings the host */
-        void ping(char const *const message);
+        /* Connects to the host (awaited on the strand) */
+        net::awaitable<void> connect(std::string host, std::string port, std::string target = "/");
 
-        /* Writes a message to the host (l-value) */
-        void write(const std::string &message);
+        /* Replaces the stream with a fresh connection to the last connected host (awaited on the strand) */
+        net::awaitable<void> reconnect();
 
-        /* Writes a message to the host (r-value) */
-        void write(const std::string &&message);
+        /* Reads the counters */
+        void getStats(Stats &output);
+
+        /* Pings the host on a timer until the client is destroyed (thread-safe) */
+        void keepAlive(std::chrono::seconds interval);
+
+        /* Queues a message to be written to the host (thread-safe, dropped if disconnected) */
+        void write(std::string message);
+
+        /**
+         * Zero-copy Reads (awaited on the strand, one at a time)
+         *
+         * The frame is exposed in place as a mutable and NUL-terminated span
+         * (suitable for in-situ parsing) that stays valid until the buffer
+         * it was read into is next read into or modified.
+         */
+
+        /* Reads a message from the host into the given buffer */
+        net::awaitable<std::span<char>> read(beast::flat_buffer &buffer);
+
+    private:
+        /* Writes the queued messages out one at a time (strand only) */
+        net::awaitable<void> writeQueued();
 
-        /* Reads a message from the host */
-        void read(std::string &output);
+        /* Pings on every tick of the timer */
+        net::awaitable<void> pingForever(std::chrono::seconds interval);
     };
 }
 
@@ -1,6 +1,8 @@
 #ifndef UTILS_BASE64_H
 #define UTILS_BASE64_H
 
+#include <cstddef>
+#include <cstdint>
 #include <stdexcept>
 #include <string>
 
@@ -36,7 +38,11 @@ namespace Utils::Base64
      * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
      */
 
-    inline void encode(const std::string &input, std::string &output)
+    /* Size of the padded encoding of inputSize bytes */
+    constexpr size_t encodedSize(size_t inputSize) { return 4 * ((inputSize + 2) / 3); }
+
+    /* Encodes into a buffer of at least encodedSize(size), returns the size written */
+    inline size_t encode(unsigned char const *input, size_t size, char *output)
     {
         static constexpr char sEncodingTable[] = {
             'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H',
@@ -48,36 +54,39 @@ namespace Utils::Base64
             'w', 'x', 'y', 'z', '0', '1', '2', '3',
             '4', '5', '6', '7', '8', '9', '+', '/'};
 
-        size_t in_len = input.size();
-        size_t out_len = 4 * ((in_len + 2) / 3);
-        std::string ret(out_len, '\0');
-        size_t i;
-        char *p = const_cast<char *>(ret.c_str());
+        char *p = output;
+        size_t i = 0;
 
-        for (i = 0; i < in_len - 2; i += 3)
+        for (; i + 2 < size; i += 3)
         {
-            *p++ = sEncodingTable[(input[i] >> 2) & 0x3F];
-            *p++ = sEncodingTable[((input[i] & 0x3) << 4) | ((int)(input[i + 1] & 0xF0) >> 4)];
-            *p++ = sEncodingTable[((input[i + 1] & 0xF) << 2) | ((int)(input[i + 2] & 0xC0) >> 6)];
+            *p++ = sEncodingTable[input[i] >> 2];
+            *p++ = sEncodingTable[((input[i] & 0x3) << 4) | (input[i + 1] >> 4)];
+            *p++ = sEncodingTable[((input[i + 1] & 0xF) << 2) | (input[i + 2] >> 6)];
             *p++ = sEncodingTable[input[i + 2] & 0x3F];
         }
-        if (i < in_len)
+        if (i < size)
         {
-            *p++ = sEncodingTable[(input[i] >> 2) & 0x3F];
-            if (i == (in_len - 1))
+            *p++ = sEncodingTable[input[i] >> 2];
+            if (i == (size - 1))
             {
                 *p++ = sEncodingTable[((input[i] & 0x3) << 4)];
                 *p++ = '=';
             }
             else
             {
-                *p++ = sEncodingTable[((input[i] & 0x3) << 4) | ((int)(input[i + 1] & 0xF0) >> 4)];
+                *p++ = sEncodingTable[((input[i] & 0x3) << 4) | (input[i + 1] >> 4)];
                 *p++ = sEncodingTable[((input[i + 1] & 0xF) << 2)];
             }
             *p++ = '=';
         }
 
-        output = ret;
+        return p - output;
+    }
+
+    inline void encode(const std::string &input, std::string &output)
+    {
+        output.resize(encodedSize(input.size()));
+        encode(reinterpret_cast<unsigned char const *>(input.data()), input.size(), output.data());
     }
 
     inline void decode(const std::string &input, std::string &output)
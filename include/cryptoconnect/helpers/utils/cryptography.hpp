@@ -1,9 +1,14 @@
 #ifndef UTILS_CRYPTOGRAPHY_H
 #define UTILS_CRYPTOGRAPHY_H
 
+#include <array>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <sstream>
 #include <iomanip>
+#include "openssl/core_names.h"
+#include "openssl/evp.h"
 #include "openssl/hmac.h"
 #include "./base64.hpp"
 
@@ -14,6 +19,9 @@ namespace Utils::Crypto
         typedef EVP_MD const *(*hashFunc_t)();
     }
 
+    /* Large enough for the digest of any hash function */
+    using digest_t = std::array<unsigned char, EVP_MAX_MD_SIZE>;
+
     /**
      * Raw HMAC to return byte array
      */
@@ -33,24 +41,27 @@ namespace Utils::Crypto
     inline void hmacBase64(std::string const &secret, std::string const &message,
                            std::string &output)
     {
-        unsigned char *result = 0;
-        unsigned int resultSize = -1;
+        // The digest may hold zero bytes, its size is the one reported
+        digest_t digest;
+        unsigned char *result = digest.data();
+        unsigned int resultSize = 0;
 
         hmac<hashFunc>(secret, message, result, resultSize);
 
-        std::string hmacString(reinterpret_cast<const char *>(result));
-        Utils::Base64::encode(hmacString, output);
+        output.resize(Utils::Base64::encodedSize(resultSize));
+        Utils::Base64::encode(result, resultSize, output.data());
     }
 
     /**
-     * HMAC to return a hexadecimal string 
+     * HMAC to return a hexadecimal string
      */
     template <hashFunc_t hashFunc>
     inline void hmacHex(std::string const &secret, std::string const &message,
                         std::string &output)
     {
-        unsigned char *result = 0;
-        unsigned int resultSize = -1;
+        digest_t digest;
+        unsigned char *result = digest.data();
+        unsigned int resultSize = 0;
 
         hmac<hashFunc>(secret, message, result, resultSize);
 
@@ -66,6 +77,59 @@ namespace Utils::Crypto
         // Assign the result string to the output
         output = os.str();
     }
+
+    /**
+     * Pre-keyed HMAC context for signing many messages with one secret
+     *
+     * The key pads are derived once and every signature restarts from
+     * them. Not thread-safe: keep one per thread.
+     */
+    template <hashFunc_t hashFunc>
+    class Hmac
+    {
+    private:
+        EVP_MAC_CTX *ctx_;
+
+    public:
+        Hmac(std::string_view secret)
+        {
+            EVP_MAC *mac = EVP_MAC_fetch(nullptr, "HMAC", nullptr);
+            this->ctx_ = mac ? EVP_MAC_CTX_new(mac) : nullptr;
+            EVP_MAC_free(mac); // The context holds its own reference
+
+            OSSL_PARAM params[] = {
+                OSSL_PARAM_construct_utf8_string(
+                    OSSL_MAC_PARAM_DIGEST, const_cast<char *>(EVP_MD_get0_name(hashFunc())), 0),
+                OSSL_PARAM_construct_end()};
+
+            if (!this->ctx_ ||
+                !EVP_MAC_init(this->ctx_, reinterpret_cast<unsigned char const *>(secret.data()),
+                              secret.size(), params))
+            {
+                EVP_MAC_CTX_free(this->ctx_);
+                throw std::runtime_error("Failed to key the HMAC context");
+            }
+        }
+
+        ~Hmac() { EVP_MAC_CTX_free(this->ctx_); }
+
+        Hmac(Hmac const &) = delete;
+        Hmac &operator=(Hmac const &) = delete;
+
+        /* Signs the message into the digest, returns the digest's size */
+        size_t sign(std::string_view message, digest_t &output)
+        {
+            size_t outputSize = 0;
+
+            // Re-initializing without a key restarts from the keyed pads
+            if (!EVP_MAC_init(this->ctx_, nullptr, 0, nullptr) ||
+                !EVP_MAC_update(this->ctx_, reinterpret_cast<unsigned char const *>(message.data()), message.size()) ||
+                !EVP_MAC_final(this->ctx_, output.data(), &outputSize, output.size()))
+                throw std::runtime_error("Failed to compute the HMAC");
+
+            return outputSize;
+        }
+    };
 }
 
 #endif
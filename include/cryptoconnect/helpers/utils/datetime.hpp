@@ -5,7 +5,9 @@
 #include <ctime>
 #include <iomanip>
 #include <chrono>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <stdio.h>
 #include <time.h>
 #include <date/date.h>
@@ -22,24 +24,62 @@ namespace Utils::Constants
 namespace Utils::Datetime
 {
 
+    /* Parses an ISO 8601 UTC time (YYYY-MM-DDTHH:MM:SS[.fraction][Z]) without allocating (false if malformed or out of range) */
     template <class T>
-    inline uint64_t isostringToEpoch(std::string const &&timeString)
+    inline bool tryIsostringToEpoch(std::string_view timeString, uint64_t &output)
     {
-        std::istringstream ss(timeString);
-        date::sys_time<T> timePoint;
-        ss >> date::parse("%FT%T", timePoint);
+        // Guard clause for anything shorter than the seconds or not laid out as a date and a time
+        if (timeString.size() < 19 || timeString[4] != '-' || timeString[7] != '-' ||
+            (timeString[10] != 'T' && timeString[10] != ' ') || timeString[13] != ':' || timeString[16] != ':')
+            return false;
 
-        return timePoint.time_since_epoch().count();
+        bool isValid = true;
+        auto digits = [&](size_t position, size_t length)
+        {
+            unsigned value = 0;
+            for (size_t i = position; i < position + length; i++)
+            {
+                char const c = timeString[i];
+                isValid &= c >= '0' && c <= '9';
+                value = value * 10 + (c - '0');
+            }
+            return value;
+        };
+
+        unsigned const year = digits(0, 4), month = digits(5, 2), day = digits(8, 2);
+        unsigned const hours = digits(11, 2), minutes = digits(14, 2), seconds = digits(17, 2);
+
+        // Fractional seconds down to the nanosecond
+        int64_t nanoseconds = 0;
+        if (timeString.size() > 20 && timeString[19] == '.')
+        {
+            int64_t scale = 100000000;
+            for (size_t i = 20; i < timeString.size() && timeString[i] >= '0' && timeString[i] <= '9'; i++, scale /= 10)
+                nanoseconds += (timeString[i] - '0') * scale;
+        }
+
+        // Every field has to be in its range (including the days of the month)
+        date::year_month_day const yearMonthDay{date::year(year), date::month(month), date::day(day)};
+        if (!isValid || year < 1970 || !yearMonthDay.ok() || hours > 23 || minutes > 59 || seconds > 59)
+            return false;
+
+        auto const timePoint = date::sys_days(yearMonthDay) +
+                               std::chrono::hours(hours) + std::chrono::minutes(minutes) +
+                               std::chrono::seconds(seconds) + std::chrono::nanoseconds(nanoseconds);
+
+        output = std::chrono::duration_cast<T>(timePoint.time_since_epoch()).count();
+        return true;
     }
 
+    /* Parses an ISO 8601 UTC time without allocating (throws std::invalid_argument if malformed or out of range) */
     template <class T>
-    inline uint64_t isostringToEpoch(std::string const &timeString)
+    inline uint64_t isostringToEpoch(std::string_view timeString)
     {
-        std::istringstream ss(timeString);
-        date::sys_time<T> timePoint;
-        ss >> date::parse("%FT%T", timePoint);
+        uint64_t output;
+        if (!tryIsostringToEpoch<T>(timeString, output))
+            throw std::invalid_argument("Invalid ISO 8601 time: " + std::string(timeString));
 
-        return timePoint.time_since_epoch().count();
+        return output;
     }
 
     inline std::string epochToIsostring(uint64_t const &epochTime)
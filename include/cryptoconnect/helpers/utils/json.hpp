@@ -0,0 +1,104 @@
+#ifndef UTILS_JSON_H
+#define UTILS_JSON_H
+
+/* Bytes preallocated per thread for the parsed values of a document (larger ones spill onto the heap) */
+#ifndef JSON_PARSE_BUFFER_SIZE
+#define JSON_PARSE_BUFFER_SIZE 262144
+#endif
+
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include <charconv>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Utils::Json
+{
+    using allocator_t = rapidjson::MemoryPoolAllocator<>;
+    using document_t = rapidjson::GenericDocument<rapidjson::UTF8<>, allocator_t, allocator_t>;
+
+    /**
+     * In-situ parser reusing its preallocated memory across documents
+     *
+     * Strings are left in the parsed text rather than copied out, so
+     * the text is clobbered and has to outlive the document. Each
+     * document is only valid until the parser's next parse.
+     */
+    class Parser
+    {
+    private:
+        /* Memory reused across documents (values and parsing stack) */
+        std::vector<char> valueBuffer_;
+        std::vector<char> stackBuffer_;
+        allocator_t valueAllocator_;
+        allocator_t stackAllocator_;
+
+        std::optional<document_t> document_;
+
+    public:
+        /* Constructor */
+        Parser(size_t bufferSize = JSON_PARSE_BUFFER_SIZE)
+            : valueBuffer_(bufferSize), stackBuffer_(bufferSize),
+              valueAllocator_(this->valueBuffer_.data(), this->valueBuffer_.size()),
+              stackAllocator_(this->stackBuffer_.data(), this->stackBuffer_.size()){};
+
+        Parser(Parser const &) = delete;
+        Parser &operator=(Parser const &) = delete;
+
+        /* The calling thread's parser */
+        static Parser &local()
+        {
+            thread_local Parser parser;
+            return parser;
+        }
+
+        /* Parses the NUL-terminated text in situ (check HasParseError) */
+        document_t &parseInsitu(char *text)
+        {
+            // Release whatever the previous document used (keeps the preallocated buffers)
+            this->document_.reset();
+            this->valueAllocator_.Clear();
+            this->stackAllocator_.Clear();
+
+            this->document_.emplace(&this->valueAllocator_, 1024, &this->stackAllocator_);
+            this->document_->ParseInsitu(text);
+            return *this->document_;
+        }
+
+        /* Parses the NUL-terminated text in situ (check HasParseError) */
+        document_t &parseInsitu(std::span<char> text) { return this->parseInsitu(text.data()); }
+
+        /* Parses the string in situ (check HasParseError) */
+        document_t &parseInsitu(std::string &text) { return this->parseInsitu(text.data()); }
+    };
+
+    /* Views a string value in place */
+    inline std::string_view view(rapidjson::Value const &value)
+    {
+        return std::string_view(value.GetString(), value.GetStringLength());
+    }
+
+    /* Reads a decimal quoted as a string value without allocating (0 if unparsable) */
+    inline double toDouble(rapidjson::Value const &value)
+    {
+        double output = 0;
+        std::from_chars(value.GetString(), value.GetString() + value.GetStringLength(), output);
+        return output;
+    }
+
+    /* Serializes a parsed value back for logging (the in-situ source is clobbered) */
+    inline std::string stringify(rapidjson::Value const &value)
+    {
+        rapidjson::StringBuffer buffer;
+        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+        value.Accept(writer);
+        return buffer.GetString();
+    }
+}
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef UTILS_MAPPEDFILE_H
+#define UTILS_MAPPEDFILE_H
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <string>
+
+namespace Utils::Storage
+{
+    /**
+     * Read-only memory mapping of a whole file.
+     *
+     * Empty if the file is missing or cannot be mapped. The mapping
+     * outlives the file's replacement by a rename, so readers keep a
+     * consistent view while a writer swaps a new version in.
+     */
+    class MappedFile
+    {
+    private:
+        void *data_ = nullptr;
+        size_t size_ = 0;
+
+    public:
+        /* Constructor */
+        MappedFile(std::string const &path)
+        {
+            int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0)
+                return;
+
+            struct stat info;
+            if (::fstat(fd, &info) == 0 && info.st_size > 0)
+            {
+                void *data = ::mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (data != MAP_FAILED)
+                {
+                    this->data_ = data;
+                    this->size_ = info.st_size;
+                }
+            }
+
+            // The mapping holds its own reference to the file
+            ::close(fd);
+        }
+
+        ~MappedFile()
+        {
+            if (this->data_)
+                ::munmap(this->data_, this->size_);
+        }
+
+        MappedFile(MappedFile const &) = delete;
+        MappedFile &operator=(MappedFile const &) = delete;
+
+        inline char const *data() const { return static_cast<char const *>(this->data_); }
+        inline size_t size() const { return this->size_; }
+        inline bool empty() const { return !this->size_; }
+    };
+}
+
+#endif
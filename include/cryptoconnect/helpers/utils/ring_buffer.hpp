@@ -0,0 +1,69 @@
+#ifndef UTILS_RINGBUFFER_H
+#define UTILS_RINGBUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace Utils::Concurrency
+{
+    /**
+     * Bounded lock-free single-producer single-consumer ring.
+     *
+     * Slots are constructed once and reused in place, so the producer
+     * can write straight into a slot (or swap its buffer with it)
+     * instead of moving elements in and out of the ring.
+     */
+    template <typename T>
+    class RingBuffer
+    {
+    private:
+        std::vector<T> slots_;
+        size_t mask_;
+
+        /* Kept on separate cache lines to avoid false sharing between the two sides */
+        alignas(64) std::atomic<size_t> head_{0}; // Next slot to be read by the consumer
+        alignas(64) std::atomic<size_t> tail_{0}; // Next slot to be written by the producer
+
+    public:
+        /* Constructor (capacity has to be a power of 2) */
+        RingBuffer(size_t capacity) : slots_(capacity), mask_(capacity - 1)
+        {
+            if (!capacity || (capacity & this->mask_))
+                throw std::invalid_argument("Ring buffer capacity must be a power of 2");
+        }
+
+        /** Producer: returns the next free slot to write into or nullptr if the ring is full */
+        inline T *acquire()
+        {
+            size_t tail = this->tail_.load(std::memory_order_relaxed);
+            if (tail - this->head_.load(std::memory_order_acquire) > this->mask_)
+                return nullptr;
+            return &this->slots_[tail & this->mask_];
+        }
+
+        /** Producer: makes the acquired slot visible to the consumer */
+        inline void publish()
+        {
+            this->tail_.store(this->tail_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+        /** Consumer: returns the oldest published slot or nullptr if the ring is empty */
+        inline T *front()
+        {
+            size_t head = this->head_.load(std::memory_order_relaxed);
+            if (head == this->tail_.load(std::memory_order_acquire))
+                return nullptr;
+            return &this->slots_[head & this->mask_];
+        }
+
+        /** Consumer: hands the front slot back to the producer */
+        inline void pop()
+        {
+            this->head_.store(this->head_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+    };
+}
+
+#endif
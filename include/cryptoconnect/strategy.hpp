@@ -28,6 +28,11 @@ namespace CryptoConnect
         virtual void onOrderStatus(Events::OrderStatus orderStatus) = 0;
         virtual void onTransaction(Events::Transaction transaction) = 0;
         virtual void onExit() = 0;
+
+        /* Optional hooks (no-op by default) */
+        virtual void onFeedStatus(Events::FeedStatus /* feedStatus */){};
+        virtual void onOrderAck(Events::OrderAck /* orderAck */){};
+        virtual void onCancelAck(Events::CancelAck /* cancelAck */){};
     };
 }
 
@@ -5,6 +5,9 @@
 
 #include <cstdint>
 #include <iostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -28,7 +31,7 @@ namespace Events
 		/* Constructor */
 		Bar(uint64_t epochTime, std::string productId, double open,
 			double high, double low, double close, double vol)
-			: epochTime_(epochTime), productId_(productId),
+			: epochTime_(epochTime), productId_(std::move(productId)),
 			  open_(open), high_(high), low_(low),
 			  close_(close), vol_(vol){};
 	};
@@ -163,8 +166,113 @@ namespace Events
 		return os;
 	}
 
+	/* FeedStatus event representing a change in the state of a market data connection */
+	struct FeedStatus
+	{
+		enum class Status
+		{
+			DISCONNECTED = 0, // Connection dropped, books of its products are stale
+			RECONNECTED = 1,  // Connection re-established and resubscribed, books being rebuilt
+			RECOVERED = 2,    // Every product on the connection has a valid book again
+			READY = 3,        // Every subscribed product has a valid book (down time holds the time to readiness)
+			PARTIAL = 4,      // Every subscribed product settled, but some timed out without a book (down time as for READY)
+			UNKNOWN = 99
+		};
+
+		uint64_t epochTime_;
+		size_t connection_;
+		Status status_;
+		uint64_t downTime_; // Nanoseconds since the disconnect (0 when disconnecting)
+		std::string message_;
+
+		/* Default Constructor for empty event */
+		FeedStatus() : epochTime_(0), connection_(0), status_(Status::UNKNOWN),
+					   downTime_(0), message_(""){};
+
+		/* Constructor */
+		FeedStatus(uint64_t epochTime, size_t connection, Status status,
+				   uint64_t downTime, std::string message)
+			: epochTime_(epochTime), connection_(connection), status_(status),
+			  downTime_(downTime), message_(message){};
+	};
+
+	inline std::ostream &operator<<(std::ostream &os, FeedStatus const &feedStatus)
+	{
+		os << "Time since epoch: " << feedStatus.epochTime_ << " | "
+		   << "Connection: " << feedStatus.connection_ << " | "
+		   << "Status: "
+		   << (feedStatus.status_ == FeedStatus::Status::DISCONNECTED
+				   ? "disconnected"
+				   : (feedStatus.status_ == FeedStatus::Status::RECONNECTED
+						  ? "reconnected"
+						  : (feedStatus.status_ == FeedStatus::Status::RECOVERED
+								 ? "recovered"
+								 : (feedStatus.status_ == FeedStatus::Status::READY
+										? "ready"
+										: (feedStatus.status_ == FeedStatus::Status::PARTIAL ? "partial" : "unknown")))))
+		   << " | "
+		   << "Down Time (ns): " << feedStatus.downTime_ << " | "
+		   << "Message: " << feedStatus.message_;
+
+		return os;
+	}
+
+	/* OrderAck event representing the exchange's response to an order submitted asynchronously */
+	struct OrderAck
+	{
+		Orders::clientOrderId_t clientOrderId_;
+		uint64_t epochTime_;
+		std::string productId_;
+		Orders::OrderResponse response_;
+		uint64_t latency_; // Nanoseconds from submission to response
+
+		/* Constructor */
+		OrderAck(Orders::clientOrderId_t clientOrderId, uint64_t epochTime, std::string productId,
+				 Orders::OrderResponse response, uint64_t latency)
+			: clientOrderId_(clientOrderId), epochTime_(epochTime), productId_(productId),
+			  response_(response), latency_(latency){};
+	};
+
+	inline std::ostream &operator<<(std::ostream &os, OrderAck const &orderAck)
+	{
+		os << "Time since epoch: " << orderAck.epochTime_ << " | "
+		   << "Security ID: " << orderAck.productId_ << " | "
+		   << "Client Order ID: " << orderAck.clientOrderId_ << " | "
+		   << "Response: " << orderAck.response_ << " | "
+		   << "Latency (ns): " << orderAck.latency_;
+
+		return os;
+	}
+
+	/* CancelAck event representing the exchange's response to a cancellation requested asynchronously */
+	struct CancelAck
+	{
+		Orders::clientOrderId_t clientOrderId_;
+		uint64_t epochTime_;
+		Orders::orderId_t id_;
+		bool isCancelled_;
+		uint64_t latency_; // Nanoseconds from request to response
+
+		/* Constructor */
+		CancelAck(Orders::clientOrderId_t clientOrderId, uint64_t epochTime, Orders::orderId_t id,
+				  bool isCancelled, uint64_t latency)
+			: clientOrderId_(clientOrderId), epochTime_(epochTime), id_(id),
+			  isCancelled_(isCancelled), latency_(latency){};
+	};
+
+	inline std::ostream &operator<<(std::ostream &os, CancelAck const &cancelAck)
+	{
+		os << "Time since epoch: " << cancelAck.epochTime_ << " | "
+		   << "Client Order ID: " << cancelAck.clientOrderId_ << " | "
+		   << "Order ID: " << cancelAck.id_ << " | "
+		   << "Cancelled: " << cancelAck.isCancelled_ << " | "
+		   << "Latency (ns): " << cancelAck.latency_;
+
+		return os;
+	}
+
 	/* Variant for a Generic Event */
-	using Event = std::variant<Bar, Tick, Trade, OrderStatus, Transaction>;
+	using Event = std::variant<Bar, Tick, Trade, OrderStatus, Transaction, FeedStatus, OrderAck, CancelAck>;
 
 	/* Overloaded utility to visit an event variant*/
 	template <class... Ts>
@@ -180,6 +288,41 @@ namespace Events
 	using bars_t = std::vector<Bar>;
 	using ticks_t = std::vector<Tick>;
 	using trades_t = std::vector<Trade>;
+
+	/* Bars of a single product as contiguous columns (ascending times, no duplicates) */
+	struct BarSeries
+	{
+		std::vector<uint64_t> epochTimes_;
+		std::vector<double> opens_, highs_, lows_, closes_, vols_;
+
+		size_t size() const { return this->epochTimes_.size(); }
+
+		void reserve(size_t size)
+		{
+			for (auto *column : {&this->opens_, &this->highs_, &this->lows_, &this->closes_, &this->vols_})
+				column->reserve(size);
+			this->epochTimes_.reserve(size);
+		}
+
+		void append(uint64_t epochTime, double open, double high, double low, double close, double vol)
+		{
+			this->epochTimes_.push_back(epochTime);
+			this->opens_.push_back(open);
+			this->highs_.push_back(high);
+			this->lows_.push_back(low);
+			this->closes_.push_back(close);
+			this->vols_.push_back(vol);
+		}
+
+		/* Bar at the index (allocates its product ID) */
+		Bar at(size_t index, std::string productId) const
+		{
+			return Bar(this->epochTimes_[index], std::move(productId), this->opens_[index],
+					   this->highs_[index], this->lows_[index], this->closes_[index], this->vols_[index]);
+		}
+	};
+
+	using barSeriesMap_t = std::unordered_map<std::string, BarSeries>;
 }
 
 #endif
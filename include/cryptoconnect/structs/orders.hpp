@@ -1,10 +1,20 @@
 #ifndef STRUCTS_ORDERES_H
 #define STRUCTS_ORDERES_H
 
+/* Room for an encoded order body (staged orders carry it inline) */
+#ifndef ORDERS_STAGED_BODY_SIZE
+#define ORDERS_STAGED_BODY_SIZE 256
+#endif
+
+#include <array>
 #include <cstdint>
+#include <functional>
 #include <iostream>
 #include <memory>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 namespace Orders
@@ -56,6 +66,58 @@ namespace Orders
     using orderId_t = std::string;
     using orderIds_t = std::vector<orderId_t>;
 
+    /* Assigned on submission, before the exchange assigns the order ID */
+    using clientOrderId_t = uint64_t;
+
+    /**
+     * Order encoded ahead of time (rounded to its product's increments)
+     *
+     * Only signing and sending are left once it is triggered. It is
+     * sent at most once, under the client order ID assigned when staged:
+     * it can only be moved, and is consumed (marked sent) by whatever
+     * sends it, moved-from orders counting as sent.
+     */
+    struct StagedOrder
+    {
+        clientOrderId_t clientOrderId_;
+        std::string productId_;
+        std::array<char, ORDERS_STAGED_BODY_SIZE> body_;
+        size_t bodySize_;
+        bool isSent_;
+
+        StagedOrder()
+            : clientOrderId_(0), productId_(""), body_{}, bodySize_(0), isSent_(false){};
+
+        StagedOrder(StagedOrder const &) = delete;
+        StagedOrder &operator=(StagedOrder const &) = delete;
+
+        StagedOrder(StagedOrder &&other) noexcept
+            : clientOrderId_(other.clientOrderId_), productId_(std::move(other.productId_)),
+              body_(other.body_), bodySize_(other.bodySize_), isSent_(std::exchange(other.isSent_, true)){};
+
+        StagedOrder &operator=(StagedOrder &&other) noexcept
+        {
+            this->clientOrderId_ = other.clientOrderId_;
+            this->productId_ = std::move(other.productId_);
+            this->body_ = other.body_;
+            this->bodySize_ = other.bodySize_;
+            this->isSent_ = std::exchange(other.isSent_, true);
+            return *this;
+        }
+
+        /* Encoded JSON body */
+        std::string_view body() const { return std::string_view(this->body_.data(), this->bodySize_); }
+
+        /* Marks the order sent (throws std::logic_error if it was never staged or already sent) */
+        void consume()
+        {
+            if (this->bodySize_ == 0)
+                throw std::logic_error("Order was never staged");
+            if (std::exchange(this->isSent_, true))
+                throw std::logic_error("Staged order " + std::to_string(this->clientOrderId_) + " was already sent");
+        }
+    };
+
     struct OrderResponse
     {
         enum class Code
@@ -74,10 +136,10 @@ namespace Orders
             : id_(""), code_(Code::EMPTY){};
 
         OrderResponse(orderId_t id, Code code)
-            : id_(id), code_(code){};
+            : id_(std::move(id)), code_(code){};
     };
 
-    inline std::ostream &operator<<(std::ostream &os, OrderResponse &orderResponse)
+    inline std::ostream &operator<<(std::ostream &os, OrderResponse const &orderResponse)
     {
         switch (orderResponse.code_)
         {
@@ -104,6 +166,16 @@ namespace Orders
         return os;
     }
 
+    /* Responses to a batch of orders (in the batch's order) */
+    struct BatchResponse
+    {
+        std::vector<OrderResponse> responses_;
+        uint64_t latency_; // Nanoseconds from the first order sent to the last response
+
+        BatchResponse()
+            : responses_(), latency_(0){};
+    };
+
     struct OrderDetails
     {
         orderId_t id_;
@@ -125,14 +197,17 @@ namespace Orders
         OrderDetails(orderId_t id, Type type, Side side, Status status,
                      uint64_t epochTime, std::string productId, double price,
                      double quantity, double quantityFilled, double fees)
-            : id_(id), type_(type), side_(side), status_(status),
-              epochTime_(epochTime), productId_(productId), price_(price),
+            : id_(std::move(id)), type_(type), side_(side), status_(status),
+              epochTime_(epochTime), productId_(std::move(productId)), price_(price),
               quantity_(quantity), quantityFilled_(quantityFilled), fees_(fees){};
     };
 
     /* Details Types */
     using orderDetailsPtr_t = std::shared_ptr<OrderDetails>;
     using ordersDetails_t = std::vector<OrderDetails>;
+
+    /* Handed each page of orders as it arrives (only valid during the call), returns whether to carry on */
+    using ordersPageHandler_t = std::function<bool(ordersDetails_t const &)>;
 }
 
 #endif
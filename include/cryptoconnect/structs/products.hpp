@@ -3,6 +3,7 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 #include <unordered_map>
 
 namespace Products
@@ -30,7 +31,8 @@ namespace Products
                 double baseMinSize, double baseMaxSize,
                 double baseIncrement, double quoteIncrement,
                 bool isTradingEnabled, bool isMarginEnabled)
-            : id_(id), name_(name), baseCurrency_(baseCurrency), quoteCurrency_(quoteCurrency),
+            : id_(std::move(id)), name_(std::move(name)),
+              baseCurrency_(std::move(baseCurrency)), quoteCurrency_(std::move(quoteCurrency)),
               baseMinSize_(baseMinSize), baseMaxSize_(baseMaxSize),
               baseIncrement_(baseIncrement), quoteIncrement_(quoteIncrement),
               isTradingEnabled_(isTradingEnabled), isMarginEnabled_(isMarginEnabled){};
@@ -38,6 +40,22 @@ namespace Products
 
     using productPtr_t = std::shared_ptr<Product>;
     using productMap_t = std::unordered_map<std::string, productPtr_t>;
+
+    /* Products listed at a point in time, never modified once published */
+    struct Catalogue
+    {
+        productMap_t products_;
+
+        /* Product of the ID or nullptr if it is not listed */
+        productPtr_t lookup(std::string const &productId) const
+        {
+            auto const it = this->products_.find(productId);
+            return it != this->products_.end() ? it->second : nullptr;
+        }
+    };
+
+    /* Published catalogues are kept alive by their publisher, so they are shared without a refcount */
+    using cataloguePtr_t = Catalogue const *;
 }
 
 #endif
@@ -10,7 +10,7 @@ namespace Universe
     struct Universe
     {
     private:
-        std::mutex mutex_;
+        mutable std::mutex mutex_; // Also taken by const readers
         std::unordered_set<std::string> universe_;
 
     public:
@@ -40,6 +40,13 @@ namespace Universe
             return this->universe_.size();
         }
 
+        inline bool contains(std::string const &productId) const
+        {
+            std::lock_guard<std::mutex> lock(this->mutex_);
+            return this->universe_.find(productId) != this->universe_.end();
+            // Lock guard goes out of scope and releases
+        }
+
         inline void update(Universe const &universe)
         {
             std::lock_guard<std::mutex> lock(this->mutex_);
@@ -72,6 +79,21 @@ namespace Universe
             // Lock guard goes out of scope and releases
         }
 
+        inline void difference(Universe const &universe)
+        {
+            // Guard clause for the difference with itself (its mutex cannot be locked twice)
+            if (&universe == this)
+            {
+                this->clear();
+                return;
+            }
+
+            std::scoped_lock lock(this->mutex_, universe.mutex_);
+            for (auto const &item : universe.universe_)
+                this->universe_.erase(item);
+            // Scoped lock goes out of scope and releases both
+        }
+
         template <typename... Args>
         inline void emplace(Args &&...args)
         {
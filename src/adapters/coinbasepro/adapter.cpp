@@ -4,20 +4,65 @@
 #include "cryptoconnect/structs/orders.hpp"
 #include "cryptoconnect/structs/products.hpp"
 #include "cryptoconnect/structs/universe.hpp"
+#include "cryptoconnect/helpers/utils/datetime.hpp"
 #include "cryptoconnect/helpers/utils/exceptions.hpp"
 #include "cryptoconnect/adapters/base.hpp"
 #include "cryptoconnect/adapters/coinbasepro/auth.hpp"
 #include "cryptoconnect/adapters/coinbasepro/rest/connector.hpp"
 #include "cryptoconnect/adapters/coinbasepro/rest/bars_scheduler.hpp"
+#include "cryptoconnect/adapters/coinbasepro/rest/history_downloader.hpp"
+#include "cryptoconnect/adapters/coinbasepro/rest/order_gateway.hpp"
+#include "cryptoconnect/adapters/coinbasepro/rest/product_catalogue.hpp"
 #include "cryptoconnect/adapters/coinbasepro/stream/connector.hpp"
-#include "cryptoconnect/adapters/coinbasepro/stream/handler.hpp"
 
+#include <charconv>
+#include <chrono>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
 #include <thread>
+#include <utility>
+#include <vector>
 
 namespace CryptoConnect::CoinbasePro
 {
+    namespace
+    {
+        /* Bar query's range in epoch seconds (throws std::invalid_argument if malformed or backwards) */
+        struct BarsQuery
+        {
+            uint64_t granularity_, start_, end_;
+
+            BarsQuery(char const *granularity, std::string const &start, std::string const &end)
+            {
+                // Digits only (no sign or whitespace), the whole string consumed
+                std::string_view const text = granularity ? granularity : "";
+                auto const [granularityEnd, ec] = std::from_chars(text.data(), text.data() + text.size(), this->granularity_);
+                if (ec != std::errc() || granularityEnd != text.data() + text.size() || !this->granularity_)
+                    throw std::invalid_argument("Invalid granularity: " + std::string(text));
+
+                if (!Utils::Datetime::tryIsostringToEpoch<std::chrono::seconds>(start, this->start_))
+                    throw std::invalid_argument("Invalid start time: " + start);
+                if (!Utils::Datetime::tryIsostringToEpoch<std::chrono::seconds>(end, this->end_))
+                    throw std::invalid_argument("Invalid end time: " + end);
+                if (this->end_ < this->start_)
+                    throw std::invalid_argument("End time " + end + " is before the start time " + start);
+            }
+        };
+    }
+
     Adapter::Adapter(BaseStrategy *strategy)
-        : BaseAdapter(strategy){};
+        : BaseAdapter(strategy)
+    {
+        // Orders staged by the connector (and its gateway) are rounded to the catalogue's products
+        this->restConnector_.setProductCatalogue(&this->productCatalogue_);
+
+        // Products are served from the persisted catalogue at once and refreshed in the background
+        this->productCatalogue_.start();
+    }
 
     void Adapter::start()
     {
@@ -43,7 +88,7 @@ namespace CryptoConnect::CoinbasePro
             {
                 Utils::Exceptions::withHandler(
                     [this]
-                    { this->streamConnector_.streamForever(this->streamHandler_); },
+                    { this->streamConnector_.streamForever(); },
                     [this]
                     { this->strategy_->onExit(); },
                     "[ERROR] Stream connector failed.");
@@ -59,7 +104,8 @@ namespace CryptoConnect::CoinbasePro
 
     void Adapter::getAvailableUniverse(Universe::Universe &output)
     {
-        this->restConnector_.getProducts(this->productMap_, output);
+        for (auto const &pair : this->productCatalogue_.get()->products_)
+            output.emplace(pair.first);
     }
 
     void Adapter::getCurrentUniverse(Universe::Universe &output)
@@ -69,37 +115,134 @@ namespace CryptoConnect::CoinbasePro
 
     Products::productPtr_t Adapter::lookupProductDetails(std::string const productId)
     {
-        if (this->productMap_.find(productId) == this->productMap_.end())
-            return nullptr;
-        return this->productMap_[productId];
+        return this->productCatalogue_.get()->lookup(productId);
     }
 
     void Adapter::updateUniverse(Universe::Universe const &universe)
     {
-        this->streamConnector_.unsubscribeProducts(this->currentUniverse_);
+        std::lock_guard<std::mutex> lock(this->universeMutex_);
+
+        // Only (un)subscribe the products that changed so the books of the others stay live
+        Universe::Universe removedUniverse(this->currentUniverse_);
+        removedUniverse.difference(universe);
+
+        Universe::Universe addedUniverse(universe);
+        addedUniverse.difference(this->currentUniverse_);
+
+        this->streamConnector_.unsubscribeProducts(removedUniverse);
         this->currentUniverse_.update(universe);
-        this->streamConnector_.subscribeProducts(this->currentUniverse_);
+        this->streamConnector_.subscribeProducts(addedUniverse);
+        // Lock guard goes out of scope and releases
     }
 
     void Adapter::getBars(std::string const &productId, char const *granularity,
                           std::string const &start, std::string const &end,
                           Events::bars_t &output)
     {
-        this->restConnector_.getBars(productId, granularity, start, end, output);
+        BarsQuery const query(granularity, start, end);
+
+        Events::barSeriesMap_t seriesMap;
+        this->candleCache_.read(
+            std::span<std::string const>(&productId, 1), query.granularity_, query.start_, query.end_, seriesMap);
+
+        // Newest first, as the exchange returns them
+        Events::BarSeries const &series = seriesMap[productId];
+        output.reserve(output.size() + series.size());
+        for (size_t i = series.size(); i-- > 0;)
+            output.push_back(series.at(i, productId));
+    }
+
+    void Adapter::getHistory(std::span<std::string const> productIds, char const *granularity,
+                             std::string const &start, std::string const &end,
+                             Events::barSeriesMap_t &output)
+    {
+        BarsQuery const query(granularity, start, end);
+        this->candleCache_.read(productIds, query.granularity_, query.start_, query.end_, output);
     }
 
     void Adapter::placeOrder(
         Orders::LimitOrder const &order,
         Orders::OrderResponse &output)
     {
-        this->restConnector_.placeOrder(order, output);
+        Orders::StagedOrder stagedOrder;
+        this->stageOrder(order, stagedOrder);
+        this->restConnector_.placeOrder(std::move(stagedOrder), output);
     }
 
     void Adapter::placeOrder(
         Orders::MarketOrder const &order,
         Orders::OrderResponse &output)
     {
-        this->restConnector_.placeOrder(order, output);
+        Orders::StagedOrder stagedOrder;
+        this->stageOrder(order, stagedOrder);
+        this->restConnector_.placeOrder(std::move(stagedOrder), output);
+    }
+
+    Orders::clientOrderId_t Adapter::submitOrder(Orders::LimitOrder const &order)
+    {
+        Orders::StagedOrder stagedOrder;
+        this->stageOrder(order, stagedOrder);
+        return this->orderGateway_.submitOrder(std::move(stagedOrder));
+    }
+
+    Orders::clientOrderId_t Adapter::submitOrder(Orders::MarketOrder const &order)
+    {
+        Orders::StagedOrder stagedOrder;
+        this->stageOrder(order, stagedOrder);
+        return this->orderGateway_.submitOrder(std::move(stagedOrder));
+    }
+
+    void Adapter::stageOrder(Orders::LimitOrder const &order, Orders::StagedOrder &output)
+    {
+        this->restConnector_.stageOrder(order, output);
+    }
+
+    void Adapter::stageOrder(Orders::MarketOrder const &order, Orders::StagedOrder &output)
+    {
+        this->restConnector_.stageOrder(order, output);
+    }
+
+    void Adapter::placeOrder(
+        Orders::StagedOrder &&order,
+        Orders::OrderResponse &output)
+    {
+        this->restConnector_.placeOrder(std::move(order), output);
+    }
+
+    Orders::clientOrderId_t Adapter::submitOrder(Orders::StagedOrder &&order)
+    {
+        return this->orderGateway_.submitOrder(std::move(order));
+    }
+
+    void Adapter::placeOrders(
+        std::span<Orders::LimitOrder const> orders,
+        Orders::BatchResponse &output)
+    {
+        // Encode every leg before the first one is sent
+        std::vector<Orders::StagedOrder> stagedOrders(orders.size());
+        for (size_t i = 0; i < orders.size(); i++)
+            this->stageOrder(orders[i], stagedOrders[i]);
+
+        this->restConnector_.placeOrders(stagedOrders, output);
+    }
+
+    void Adapter::placeOrders(
+        std::span<Orders::MarketOrder const> orders,
+        Orders::BatchResponse &output)
+    {
+        // Encode every leg before the first one is sent
+        std::vector<Orders::StagedOrder> stagedOrders(orders.size());
+        for (size_t i = 0; i < orders.size(); i++)
+            this->stageOrder(orders[i], stagedOrders[i]);
+
+        this->restConnector_.placeOrders(stagedOrders, output);
+    }
+
+    void Adapter::placeOrders(
+        std::span<Orders::StagedOrder> orders,
+        Orders::BatchResponse &output)
+    {
+        this->restConnector_.placeOrders(orders, output);
     }
 
     void Adapter::getOrder(std::string const &orderId, Orders::OrderDetails &output)
@@ -122,11 +265,29 @@ namespace CryptoConnect::CoinbasePro
         this->restConnector_.getAllOrders(productId, status, output);
     }
 
+    void Adapter::getAllOrders(
+        std::string const &productId,
+        Orders::Status const status,
+        Orders::ordersPageHandler_t const &handler)
+    {
+        this->restConnector_.getAllOrders(productId, status, handler);
+    }
+
     bool Adapter::cancelOrder(std::string const &orderId)
     {
         return this->restConnector_.cancelOrder(orderId);
     }
 
+    Orders::clientOrderId_t Adapter::cancelOrderAsync(std::string const &orderId)
+    {
+        return this->orderGateway_.cancelOrder(orderId);
+    }
+
+    Orders::clientOrderId_t Adapter::cancelOrderAsync(Orders::clientOrderId_t const orderClientOrderId)
+    {
+        return this->orderGateway_.cancelOrder(orderClientOrderId);
+    }
+
     void Adapter::cancelAllOrders(Orders::orderIds_t &output)
     {
         this->restConnector_.cancelAllOrders(output);
@@ -139,6 +300,31 @@ namespace CryptoConnect::CoinbasePro
         this->restConnector_.cancelAllOrders(productId, output);
     }
 
+    void Adapter::cancelOrders(
+        Orders::orderIds_t const &orderIds,
+        Orders::orderIds_t &output)
+    {
+        this->restConnector_.cancelOrders(orderIds, output);
+    }
+
+    void Adapter::cancelAllOrders(
+        std::span<std::string const> productIds,
+        Orders::orderIds_t &output)
+    {
+        this->restConnector_.cancelAllOrders(productIds, output);
+    }
+
+    void Adapter::getPoolStats(Network::HTTP::PoolStats &publicOutput, Network::HTTP::PoolStats &privateOutput)
+    {
+        this->restConnector_.getStats(publicOutput, privateOutput);
+    }
+
+    void Adapter::getThrottleStats(Network::HTTP::throttleStats_t &publicOutput,
+                                   Network::HTTP::throttleStats_t &privateOutput)
+    {
+        this->restConnector_.getThrottleStats(publicOutput, privateOutput);
+    }
+
     void Adapter::feedStrategyForever()
     {
         while (1)
@@ -157,7 +343,13 @@ namespace CryptoConnect::CoinbasePro
                     [this](Events::OrderStatus &orderStatus)
                     { this->strategy_->onOrderStatus(orderStatus); },
                     [this](Events::Transaction &transaction)
-                    { this->strategy_->onTransaction(transaction); }},
+                    { this->strategy_->onTransaction(transaction); },
+                    [this](Events::FeedStatus &feedStatus)
+                    { this->strategy_->onFeedStatus(feedStatus); },
+                    [this](Events::OrderAck &orderAck)
+                    { this->strategy_->onOrderAck(orderAck); },
+                    [this](Events::CancelAck &cancelAck)
+                    { this->strategy_->onCancelAck(cancelAck); }},
                 event);
         }
     }
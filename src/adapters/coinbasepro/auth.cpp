@@ -5,16 +5,61 @@
 #include "cryptoconnect/helpers/utils/cryptography.hpp"
 
 #include <yaml/yaml.hpp>
-#include <boost/algorithm/string/replace.hpp>
+#include <openssl/evp.h>
 
-#include <cstdlib>
+#include <atomic>
+#include <charconv>
+#include <cstdint>
 #include <chrono>
-#include <iomanip>
-#include <sstream>
+#include <memory>
+#include <string>
+#include <string_view>
 
 namespace CryptoConnect::CoinbasePro
 {
-    Auth::Auth()
+    namespace
+    {
+        using hmac_t = Utils::Crypto::Hmac<EVP_sha256>;
+
+        /* Identifies the instances so that a thread's HMAC is re-keyed when signing for another one */
+        std::atomic<uint64_t> nextAuthId{0};
+
+        /* Calling thread's HMAC keyed with the instance's secret */
+        hmac_t &threadHmac(uint64_t const authId, std::string const &secretKey)
+        {
+            thread_local std::unique_ptr<hmac_t> hmac;
+            thread_local uint64_t keyedAuthId = UINT64_MAX;
+
+            if (keyedAuthId != authId)
+            {
+                hmac = std::make_unique<hmac_t>(secretKey);
+                keyedAuthId = authId;
+            }
+
+            return *hmac;
+        }
+
+        /* Epoch seconds as a string, formatted once per second per thread */
+        std::string_view timestampNow()
+        {
+            thread_local int64_t cachedSeconds = -1;
+            thread_local char buffer[24];
+            thread_local size_t size = 0;
+
+            int64_t const seconds = std::chrono::duration_cast<std::chrono::seconds>(
+                                        std::chrono::system_clock::now().time_since_epoch())
+                                        .count();
+            if (seconds != cachedSeconds)
+            {
+                size = std::to_chars(buffer, buffer + sizeof(buffer), seconds).ptr - buffer;
+                cachedSeconds = seconds;
+            }
+
+            return std::string_view(buffer, size);
+        }
+    }
+
+    Auth::Auth() : id_(nextAuthId++)
     {
         Yaml::Node config;
         Yaml::Parse(config, "config.yaml");
@@ -30,41 +75,45 @@ namespace CryptoConnect::CoinbasePro
     /* Decorator to add headers into the request*/
     void Auth::addAuthHeaders(Network::HTTP::request_t &req)
     {
-        // Get the timestamp now in string (CoinbasePro uses seconds)
-        std::string timestampString;
-        this->getTimestampString(timestampString);
+        // Get the timestamp now (CoinbasePro uses seconds)
+        std::string_view const timestamp = timestampNow();
+
+        // Construct the auth message into the thread's reused buffer
+        thread_local std::string authMessage;
+        authMessage.clear();
+        auto const method = req.method_string();
+        auto const target = req.target();
+        authMessage.append(timestamp)
+            .append(method.data(), method.size())
+            .append(target.data(), target.size())
+            .append(req.body());
 
-        // Construct the auth message
-        std::stringstream authMessage;
-        authMessage << timestampString << req.method() << req.target() << req.body();
+        // Sign with the pre-keyed HMAC and encode on the stack
+        Utils::Crypto::digest_t digest;
+        size_t const digestSize = threadHmac(this->id_, this->secretKey_).sign(authMessage, digest);
 
-        // Get the HMAC string
-        std::string hmacBase64String;
-        this->getSignature(authMessage.str(), hmacBase64String);
+        char signature[Utils::Base64::encodedSize(EVP_MAX_MD_SIZE)];
+        size_t const signatureSize = Utils::Base64::encode(digest.data(), digestSize, signature);
 
         // Set the headers for the CoinbasePro request
         req.set("Content-Type", "application/json");
         req.set("CB-ACCESS-KEY", this->apiKey_);
-        req.set("CB-ACCESS-TIMESTAMP", timestampString);
-        req.set("CB-ACCESS-SIGN", hmacBase64String);
+        req.set("CB-ACCESS-TIMESTAMP", beast::string_view(timestamp.data(), timestamp.size()));
+        req.set("CB-ACCESS-SIGN", beast::string_view(signature, signatureSize));
         req.set("CB-ACCESS-PASSPHRASE", this->passPhrase_);
     }
 
     void Auth::getTimestampString(std::string &output)
     {
-        output = std::to_string(
-            std::chrono::duration_cast<std::chrono::seconds>(
-                std::chrono::system_clock::now().time_since_epoch())
-                .count());
+        output = timestampNow();
     }
 
     void Auth::getSignature(std::string const &message, std::string &output)
     {
-        Utils::Crypto::hmacBase64<EVP_sha256>(this->secretKey_, message, output);
+        Utils::Crypto::digest_t digest;
+        size_t const digestSize = threadHmac(this->id_, this->secretKey_).sign(message, digest);
 
-        // Strip away any invalid characters
-        boost::replace_all(output, " ", "");
-        boost::replace_all(output, "\n", "");
+        output.resize(Utils::Base64::encodedSize(digestSize));
+        Utils::Base64::encode(digest.data(), digestSize, output.data());
     }
-
 }
@@ -1,18 +1,23 @@
 #include "cryptoconnect/adapters/coinbasepro/rest/bars_scheduler.hpp"
 
 #include "cryptoconnect/helpers/utils/datetime.hpp"
+#include "cryptoconnect/helpers/utils/json.hpp"
 #include "cryptoconnect/structs/events.hpp"
 #include "cryptoconnect/structs/universe.hpp"
 #include "cryptoconnect/adapters/coinbasepro/rest/connector.hpp"
 
-#include <boost/asio/thread_pool.hpp>
+#include <boost/asio/use_future.hpp>
 #include <rapidjson/document.h>
-#include <rapidjson/stringbuffer.h>
-#include <rapidjson/writer.h>
 
 #include <cstdint>
 #include <chrono>
+#include <exception>
+#include <future>
+#include <iostream>
+#include <string>
 #include <thread>
+#include <utility>
+#include <vector>
 
 namespace CryptoConnect::CoinbasePro::REST
 {
@@ -90,51 +95,57 @@ namespace CryptoConnect::CoinbasePro::REST
         std::string end = Utils::Datetime::epochToIsostring((this->currentMinute_ - 1) * Utils::Constants::c_sInMinute);
         std::string start = Utils::Datetime::epochToIsostring((this->currentMinute_ - 1) * Utils::Constants::c_sInMinute - 5); // just offset 5 seconds is enough
 
-        boost::asio::thread_pool pool(BAR_QUERY_THREADS);
+        // Put every product's query in flight at once (multiplexed over the connector's async connections)
+        std::vector<std::pair<std::string const *, std::future<std::string>>> queries;
+        queries.reserve(this->currentUniverse_->size());
         for (auto const &productId : (*this->currentUniverse_))
+            queries.emplace_back(
+                &productId,
+                this->restConnector_->getRawBarsAsync(productId, "60", start, end, boost::asio::use_future));
+
+        // Parse the responses as they come in
+        for (auto &[productId, query] : queries)
         {
-            boost::asio::post(
-                pool,
-                [&]()
-                {
-                    // Fetch the raw minute bars
-                    std::string response;
-                    this->restConnector_->getRawBars(
-                        productId, "60", start, end, response);
-
-                    // Parse the response
-                    rapidjson::Document document;
-                    document.Parse(response.c_str());
-
-                    if (!document.IsArray())
-                    {
-                        std::cerr << "Invalid bars response for "
-                                  << productId << " " << response << '\n';
-                        return;
-                    }
-
-                    if (!document.GetArray().Size())
-                    {
-                        std::cerr << "No bars received for "
-                                  << productId << " " << response << '\n';
-                        return;
-                    }
-
-                    for (auto const &barJson : document.GetArray())
-                    {
-                        this->eventQueue_->enqueue<Events::Bar>(
-                            (barJson[0].GetUint64() + 60) * 1000000000, // epoch time in nanoseconds (+1 since coinbase gives time as start of agg interval)
-                            productId,                                  // productId
-                            barJson[3].GetDouble(),                     // open
-                            barJson[2].GetDouble(),                     // high
-                            barJson[1].GetDouble(),                     // low
-                            barJson[4].GetDouble(),                     // close
-                            barJson[5].GetDouble()                      // volume
-                        );
-                        break;
-                    }
-                });
+            std::string response;
+            try
+            {
+                response = query.get();
+            }
+            catch (std::exception const &e)
+            {
+                std::cerr << "Failed to query bars for " << *productId << " " << e.what() << '\n';
+                continue;
+            }
+
+            // Parse in place with the thread's reused parser
+            auto &document = Utils::Json::Parser::local().parseInsitu(response);
+
+            if (document.HasParseError() || !document.IsArray())
+            {
+                std::cerr << "Invalid bars response for " << *productId << " "
+                          << (document.HasParseError() ? "(unparsable)" : Utils::Json::stringify(document)) << '\n';
+                continue;
+            }
+
+            if (!document.GetArray().Size())
+            {
+                std::cerr << "No bars received for " << *productId << '\n';
+                continue;
+            }
+
+            for (auto const &barJson : document.GetArray())
+            {
+                this->eventQueue_->enqueue<Events::Bar>(
+                    (barJson[0].GetUint64() + 60) * 1000000000, // epoch time in nanoseconds (+1 since coinbase gives time as start of agg interval)
+                    *productId,                                 // productId
+                    barJson[3].GetDouble(),                     // open
+                    barJson[2].GetDouble(),                     // high
+                    barJson[1].GetDouble(),                     // low
+                    barJson[4].GetDouble(),                     // close
+                    barJson[5].GetDouble()                      // volume
+                );
+                break;
+            }
         }
-        pool.join();
     }
 }
@@ -0,0 +1,345 @@
+#include "cryptoconnect/adapters/coinbasepro/rest/candle_cache.hpp"
+
+#include "cryptoconnect/adapters/coinbasepro/rest/history_downloader.hpp"
+#include "cryptoconnect/helpers/utils/datetime.hpp"
+#include "cryptoconnect/helpers/utils/mapped_file.hpp"
+#include "cryptoconnect/structs/events.hpp"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace CryptoConnect::CoinbasePro::REST
+{
+    namespace
+    {
+        constexpr char c_magic[8] = {'C', 'C', 'B', 'A', 'R', 'S', '0', '1'};
+
+        /* Followed by the coverage, then the epoch times, opens, highs, lows, closes and volumes columns */
+        struct FileHeader
+        {
+            char magic_[8];
+            uint64_t granularity_;
+            uint64_t numCoverage_;
+            uint64_t numBars_;
+        };
+
+        template <typename T>
+        std::span<T const> column(char const *&cursor, size_t size)
+        {
+            std::span<T const> output(reinterpret_cast<T const *>(cursor), size);
+            cursor += size * sizeof(T);
+            return output;
+        }
+
+        /* View over a mapped file's columns (empty if it is not a candle file of the granularity) */
+        CandleView mapView(std::shared_ptr<Utils::Storage::MappedFile const> file, uint64_t granularity)
+        {
+            if (file->size() < sizeof(FileHeader))
+                return CandleView();
+
+            FileHeader header;
+            std::memcpy(&header, file->data(), sizeof(FileHeader));
+
+            if (std::memcmp(header.magic_, c_magic, sizeof(c_magic)) || header.granularity_ != granularity ||
+                header.numCoverage_ > file->size() || header.numBars_ > file->size() ||
+                file->size() != sizeof(FileHeader) + header.numCoverage_ * sizeof(CandleCoverage) +
+                                    header.numBars_ * (sizeof(uint64_t) + 5 * sizeof(double)))
+                return CandleView();
+
+            char const *cursor = file->data() + sizeof(FileHeader);
+            CandleView view;
+            view.coverage_ = column<CandleCoverage>(cursor, header.numCoverage_);
+            view.epochTimes_ = column<uint64_t>(cursor, header.numBars_);
+            view.opens_ = column<double>(cursor, header.numBars_);
+            view.highs_ = column<double>(cursor, header.numBars_);
+            view.lows_ = column<double>(cursor, header.numBars_);
+            view.closes_ = column<double>(cursor, header.numBars_);
+            view.vols_ = column<double>(cursor, header.numBars_);
+            view.file_ = std::move(file);
+            return view;
+        }
+
+        /* View over bars held in memory */
+        CandleView seriesView(Events::BarSeries const &series)
+        {
+            CandleView view;
+            view.epochTimes_ = series.epochTimes_;
+            view.opens_ = series.opens_;
+            view.highs_ = series.highs_;
+            view.lows_ = series.lows_;
+            view.closes_ = series.closes_;
+            view.vols_ = series.vols_;
+            return view;
+        }
+
+        /* Appends the view's bars from index `from` to `to` in bulk */
+        void appendRange(CandleView const &view, size_t from, size_t to, Events::BarSeries &output)
+        {
+            auto copy = [from, to](auto column, auto &outputColumn)
+            { outputColumn.insert(outputColumn.end(), column.begin() + from, column.begin() + to); };
+
+            copy(view.epochTimes_, output.epochTimes_);
+            copy(view.opens_, output.opens_);
+            copy(view.highs_, output.highs_);
+            copy(view.lows_, output.lows_);
+            copy(view.closes_, output.closes_);
+            copy(view.vols_, output.vols_);
+        }
+
+        /* Merges the bars of both views between the epoch times (nanoseconds, inclusive), the latter's winning ties */
+        void merge(CandleView const &base, CandleView const &update, uint64_t from, uint64_t to,
+                   Events::BarSeries &output)
+        {
+            auto bounds = [from, to](std::span<uint64_t const> epochTimes)
+            {
+                return std::make_pair(
+                    std::lower_bound(epochTimes.begin(), epochTimes.end(), from) - epochTimes.begin(),
+                    std::upper_bound(epochTimes.begin(), epochTimes.end(), to) - epochTimes.begin());
+            };
+            auto [i, iEnd] = bounds(base.epochTimes_);
+            auto [j, jEnd] = bounds(update.epochTimes_);
+
+            output.reserve(output.size() + (iEnd - i) + (jEnd - j));
+            while (i < iEnd || j < jEnd)
+            {
+                // Copy the run of base bars before the next update in bulk
+                auto run = j < jEnd
+                               ? std::lower_bound(base.epochTimes_.begin() + i, base.epochTimes_.begin() + iEnd,
+                                                  update.epochTimes_[j]) -
+                                     base.epochTimes_.begin()
+                               : iEnd;
+                appendRange(base, i, run, output);
+                i = run;
+
+                if (j < jEnd)
+                {
+                    if (i < iEnd && base.epochTimes_[i] == update.epochTimes_[j])
+                        i++;
+                    appendRange(update, j, j + 1, output);
+                    j++;
+                }
+            }
+        }
+
+        /* Ranges between start and end (aligned to the granularity) the coverage is missing */
+        std::vector<CandleCoverage> uncovered(std::span<CandleCoverage const> coverage,
+                                              uint64_t start, uint64_t end, uint64_t granularity)
+        {
+            std::vector<CandleCoverage> output;
+            uint64_t cursor = start;
+            for (auto const &range : coverage)
+            {
+                if (range.end_ < cursor)
+                    continue;
+                if (range.start_ > end)
+                    break;
+                if (range.start_ > cursor)
+                    output.push_back(CandleCoverage{cursor, range.start_ - granularity});
+                cursor = range.end_ + granularity;
+            }
+
+            if (cursor <= end)
+                output.push_back(CandleCoverage{cursor, end});
+
+            return output;
+        }
+
+        /* Orders the coverage and joins the overlapping or adjacent ranges */
+        void coalesce(std::vector<CandleCoverage> &coverage, uint64_t granularity)
+        {
+            std::sort(coverage.begin(), coverage.end(),
+                      [](CandleCoverage const &a, CandleCoverage const &b)
+                      { return a.start_ < b.start_; });
+
+            size_t size = 0;
+            for (auto const &range : coverage)
+            {
+                if (size && range.start_ <= coverage[size - 1].end_ + granularity)
+                    coverage[size - 1].end_ = std::max(coverage[size - 1].end_, range.end_);
+                else
+                    coverage[size++] = range;
+            }
+            coverage.resize(size);
+        }
+
+        void writeFile(std::string const &path, uint64_t granularity,
+                       std::span<CandleCoverage const> coverage, Events::BarSeries const &bars)
+        {
+            // Written aside then renamed over, so mapped readers never see a partial file
+            std::string const tempPath = path + ".tmp" + std::to_string(::getpid());
+            {
+                std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+
+                FileHeader header{};
+                std::memcpy(header.magic_, c_magic, sizeof(c_magic));
+                header.granularity_ = granularity;
+                header.numCoverage_ = coverage.size();
+                header.numBars_ = bars.size();
+
+                auto write = [&file](auto const *data, size_t size)
+                { file.write(reinterpret_cast<char const *>(data), size * sizeof(*data)); };
+
+                write(&header, 1);
+                write(coverage.data(), coverage.size());
+                write(bars.epochTimes_.data(), bars.size());
+                for (auto const *values : {&bars.opens_, &bars.highs_, &bars.lows_, &bars.closes_, &bars.vols_})
+                    write(values->data(), bars.size());
+
+                if (!file.flush())
+                {
+                    std::filesystem::remove(tempPath);
+                    throw std::runtime_error("Failed to write " + tempPath);
+                }
+            }
+
+            std::filesystem::rename(tempPath, path);
+        }
+    }
+
+    void CandleCache::read(
+        std::span<std::string const> productIds,
+        uint64_t granularity,
+        uint64_t start,
+        uint64_t end,
+        Events::barSeriesMap_t &output)
+    {
+        // Guard clause for an empty range
+        if (!granularity || end < start)
+            return;
+
+        // Bars start on multiples of the granularity, the ones after the last closed bar are still forming
+        start -= start % granularity;
+        uint64_t const now = Utils::Datetime::epochNow<std::chrono::seconds>();
+        uint64_t const lastClosed = now >= granularity ? (now - granularity) / granularity * granularity : 0;
+
+        // The last few closed bars may still be revised, only the ones before them are cached
+        uint64_t const settleSpan = COINBASEPRO_CANDLE_CACHE_SETTLE_BARS * granularity;
+        uint64_t const lastSettled = lastClosed >= settleSpan ? lastClosed - settleSpan : 0;
+        uint64_t const cachedEnd = std::min(end - end % granularity, lastSettled);
+
+        // Download only what the files are missing, along with the unsettled bars
+        std::vector<CandleView> cached;
+        cached.reserve(productIds.size());
+        std::vector<HistoryDownloader::Range> ranges;
+        std::vector<size_t> firstRanges(productIds.size() + 1);
+        for (size_t i = 0; i < productIds.size(); i++)
+        {
+            cached.push_back(this->view(productIds[i], granularity));
+            firstRanges[i] = ranges.size();
+
+            if (start <= cachedEnd)
+                for (auto const &gap : uncovered(cached[i].coverage_, start, cachedEnd, granularity))
+                    ranges.emplace_back(productIds[i], gap.start_, gap.end_);
+
+            if (end > lastSettled)
+                ranges.emplace_back(productIds[i], std::max(start, lastSettled + granularity), end);
+        }
+        firstRanges[productIds.size()] = ranges.size();
+
+        if (!ranges.empty())
+            this->historyDownloader_->download(ranges, granularity);
+
+        for (size_t i = 0; i < productIds.size(); i++)
+        {
+            // Downloaded bars trimmed to their (ordered) ranges, the settled ones of complete ranges are kept
+            Events::BarSeries downloaded, settled;
+            std::vector<CandleCoverage> coverage;
+            for (size_t k = firstRanges[i]; k < firstRanges[i + 1]; k++)
+            {
+                auto const &range = ranges[k];
+                CandleView const rangeView = seriesView(range.bars_);
+                merge(CandleView(), rangeView, range.start_ * 1000000000, range.end_ * 1000000000, downloaded);
+
+                if (range.isComplete_ && range.end_ <= lastSettled)
+                {
+                    merge(CandleView(), rangeView, range.start_ * 1000000000, range.end_ * 1000000000, settled);
+                    coverage.push_back(CandleCoverage{range.start_, range.end_});
+                }
+            }
+
+            CandleView view = cached[i];
+            if (!coverage.empty())
+            {
+                try
+                {
+                    view = this->store(productIds[i], granularity, coverage, seriesView(settled));
+                }
+                catch (std::exception const &e)
+                {
+                    std::cerr << "Failed to cache the bars of " << productIds[i] << ": " << e.what() << '\n';
+                }
+            }
+
+            Events::BarSeries &series = output[productIds[i]];
+            series = Events::BarSeries();
+            merge(view, seriesView(downloaded), start * 1000000000, end * 1000000000, series);
+        }
+    }
+
+    CandleView CandleCache::view(std::string const &productId, uint64_t granularity)
+    {
+        std::string const path = this->path(productId, granularity);
+
+        std::shared_ptr<Utils::Storage::MappedFile const> file;
+        {
+            std::lock_guard<std::mutex> lock(this->mutex_);
+
+            auto &entry = this->files_[path];
+            if (!entry)
+                entry = std::make_shared<Utils::Storage::MappedFile const>(path);
+            file = entry;
+
+            // Lock guard goes out of scope and releases
+        }
+
+        return mapView(std::move(file), granularity);
+    }
+
+    std::string CandleCache::path(std::string const &productId, uint64_t granularity) const
+    {
+        return this->directory_ + '/' + productId + '-' + std::to_string(granularity) + ".bars";
+    }
+
+    CandleView CandleCache::store(
+        std::string const &productId,
+        uint64_t granularity,
+        std::span<CandleCoverage const> coverage,
+        CandleView const &downloaded)
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        std::string const path = this->path(productId, granularity);
+
+        // Merge onto the latest version (another read or process may have stored since it was mapped)
+        CandleView const current = mapView(std::make_shared<Utils::Storage::MappedFile const>(path), granularity);
+
+        std::vector<CandleCoverage> mergedCoverage(current.coverage_.begin(), current.coverage_.end());
+        mergedCoverage.insert(mergedCoverage.end(), coverage.begin(), coverage.end());
+        coalesce(mergedCoverage, granularity);
+
+        Events::BarSeries bars;
+        merge(current, downloaded, 0, std::numeric_limits<uint64_t>::max(), bars);
+
+        std::filesystem::create_directories(this->directory_);
+        writeFile(path, granularity, mergedCoverage, bars);
+
+        auto file = std::make_shared<Utils::Storage::MappedFile const>(path);
+        this->files_[path] = file;
+        return mapView(std::move(file), granularity);
+    }
+}
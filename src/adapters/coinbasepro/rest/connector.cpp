@@ -1,31 +1,87 @@
 #include "cryptoconnect/adapters/coinbasepro/rest/connector.hpp"
 
 #include "cryptoconnect/helpers/network/http/session.hpp"
+#include "cryptoconnect/helpers/network/http/session_pool.hpp"
 #include "cryptoconnect/helpers/utils/datetime.hpp"
+#include "cryptoconnect/helpers/utils/json.hpp"
 #include "cryptoconnect/structs/events.hpp"
 #include "cryptoconnect/structs/orders.hpp"
 #include "cryptoconnect/structs/products.hpp"
 #include "cryptoconnect/structs/universe.hpp"
 #include "cryptoconnect/adapters/coinbasepro/auth.hpp"
+#include "cryptoconnect/adapters/coinbasepro/rest/decoders.hpp"
+#include "cryptoconnect/adapters/coinbasepro/rest/order_encoder.hpp"
+#include "cryptoconnect/adapters/coinbasepro/rest/product_catalogue.hpp"
 
 #include <boost/asio/thread_pool.hpp>
+#include <boost/asio/use_future.hpp>
 #include <rapidjson/document.h>
-#include <rapidjson/stringbuffer.h>
-#include <rapidjson/writer.h>
 
+#include <algorithm>
+#include <chrono>
+#include <exception>
 #include <future>
+#include <iostream>
 #include <memory>
+#include <span>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <utility>
+#include <vector>
 
 namespace CryptoConnect::CoinbasePro::REST
 {
     Connector::Connector(Auth *auth) : auth_(auth)
     {
-        // Add the auth request decorator to the private session
-        this->privateSession_.addRequestDecorator(
+        // Add the auth request decorator to the private sessions
+        this->privatePool_.addRequestDecorator(
             [this](Network::HTTP::request_t &req)
             { this->auth_->addAuthHeaders(req); });
+        for (auto *session : {&this->asyncPrivateSession_, &this->asyncCancelSession_})
+            session->addRequestDecorator(
+                [this](Network::HTTP::request_t &req)
+                { this->auth_->addAuthHeaders(req); });
+
+        // Open a session on each side upfront and keep them warm (pings are metered behind every other request)
+        this->publicPool_.warmUp(1);
+        this->publicPool_.keepAlive(
+            std::chrono::seconds(COINBASEPRO_REST_KEEPALIVE_S), "/time", 1, &this->publicLimiter_);
+        this->privatePool_.warmUp(1);
+        this->privatePool_.keepAlive(
+            std::chrono::seconds(COINBASEPRO_REST_KEEPALIVE_S), "/time", 1, &this->privateLimiter_);
+        this->asyncCancelSession_.keepWarm(
+            COINBASEPRO_REST_WARM_CANCEL_CONNECTIONS, std::chrono::seconds(COINBASEPRO_REST_KEEPALIVE_S), "/time",
+            &this->privateLimiter_);
+
+        // A basket's legs are entered together, each on a warm connection of its own (never more than the session opens)
+        this->asyncPrivateSession_.keepWarm(
+            std::min<size_t>(COINBASEPRO_REST_WARM_ORDER_CONNECTIONS, COINBASEPRO_REST_ASYNC_CONNECTIONS),
+            std::chrono::seconds(COINBASEPRO_REST_KEEPALIVE_S), "/time", &this->privateLimiter_);
+
+        // Drive the asynchronous requests (kept running by the work guard)
+        for (size_t i = 0; i < COINBASEPRO_REST_IO_THREADS; i++)
+        {
+            std::thread ioThread([this]
+                                 { this->ioc_.run(); });
+            ioThread.detach();
+        }
+    }
+
+    /* Reads the session pools' counters */
+    void Connector::getStats(Network::HTTP::PoolStats &publicOutput, Network::HTTP::PoolStats &privateOutput)
+    {
+        this->publicPool_.getStats(publicOutput);
+        this->privatePool_.getStats(privateOutput);
+    }
+
+    /* Reads the time spent throttled per endpoint */
+    void Connector::getThrottleStats(Network::HTTP::throttleStats_t &publicOutput,
+                                     Network::HTTP::throttleStats_t &privateOutput)
+    {
+        this->publicLimiter_.getStats(publicOutput);
+        this->privateLimiter_.getStats(privateOutput);
     }
 
     void Connector::getProducts(
@@ -59,42 +115,20 @@ namespace CryptoConnect::CoinbasePro::REST
          * ]
          */
 
-        std::string productsResponse;
-        this->publicSession_.get("/products", productsResponse);
-
-        // Parse the JSON response
-        rapidjson::Document symbolsDocument;
-        symbolsDocument.Parse(productsResponse.c_str());
-
-        // Clear the existing product map
-        // Shared pointers will de-allocate since map is no longer pointing to it
-        productMapOutput.clear();
-
-        // Iterate and emplace into the output obj
-        for (auto const &productDetailsObj : symbolsDocument.GetArray())
-        {
-            auto productId = productDetailsObj["id"].GetString();
-
-            auto productPtr = std::make_shared<Products::Product>(
-                productId,
-                productDetailsObj["display_name"].GetString(),
-                productDetailsObj["base_currency"].GetString(),
-                productDetailsObj["quote_currency"].GetString(),
-                std::stod(productDetailsObj["base_min_size"].GetString()),
-                std::stod(productDetailsObj["base_max_size"].GetString()),
-                std::stod(productDetailsObj["base_increment"].GetString()),
-                std::stod(productDetailsObj["quote_increment"].GetString()),
-                productDetailsObj.HasMember("trading_disabled")
-                    ? !productDetailsObj["trading_disabled"].GetBool()
-                    : true,
-                productDetailsObj["margin_enabled"].GetBool());
-
-            // Register the product
-            productMapOutput[productId] = productPtr;
-
-            // Record the symbol as avaiable unviverse
-            availableUniverseOutput.emplace(productId);
-        }
+        Network::HTTP::withRetries(
+            this->retryPolicy_, true,
+            [&]
+            {
+                this->publicLimiter_.acquire(Network::HTTP::Priority::NORMAL, "GET /products");
+                this->publicPool_.get(
+                    "/products",
+                    [&](std::span<char> response)
+                    { Decoders::parseProducts(response, productMapOutput); });
+            });
+
+        // Record the symbols as available universe
+        for (auto const &pair : productMapOutput)
+            availableUniverseOutput.emplace(pair.first);
     }
 
     void Connector::getMinuteBars(std::string const &productId, std::string const &start,
@@ -128,129 +162,176 @@ namespace CryptoConnect::CoinbasePro::REST
          *   ], ...
          * ]
          */
-        std::string response;
-        this->getRawBars(productId, granularity, start, end, response);
-
-        rapidjson::Document document;
-        document.Parse(response.c_str());
-
-        if (!document.IsArray())
-        {
-            std::cerr << "No bars received for " << productId << " | " << response << '\n';
-            return;
-        }
-
-        for (auto const &barJson : document.GetArray())
-            output.emplace_back(
-                barJson[0].GetUint64() * 1000000000, // epoch time in nanoseconds
-                productId,                           // productId
-                barJson[3].GetDouble(),              // open
-                barJson[2].GetDouble(),              // high
-                barJson[1].GetDouble(),              // low
-                barJson[4].GetDouble(),              // close
-                barJson[5].GetDouble()               // volume
-            );
+        this->getRawBars(
+            productId, granularity, start, end,
+            [&](std::span<char> response)
+            { Decoders::parseBars(productId, response, output); });
     }
 
     void Connector::getRawBars(std::string const &productId, char const *granularity,
                                std::string const &start, std::string const &end,
-                               std::string &output)
+                               Network::HTTP::responseHandler_t const &handler)
     {
         std::string target = "/products/" + productId + "/candles?granularity=" + granularity + "&start=" + start + "&end=" + end;
-        this->publicSession_.isolatedGet(target.c_str(), output);
+        Network::HTTP::withRetries(
+            this->retryPolicy_, true,
+            [&]
+            {
+                this->publicLimiter_.acquire(Network::HTTP::Priority::LOW, "GET /products/candles");
+                this->publicPool_.get(target.c_str(), handler);
+            });
+    }
+
+    /* Metered asynchronous public GET */
+    net::awaitable<std::string> Connector::getPublicAsync(Network::HTTP::Priority priority, char const *endpoint,
+                                                          std::string target)
+    {
+        co_await this->publicLimiter_.asyncAcquire(priority, endpoint);
+        co_return co_await this->asyncPublicSession_.request(http::verb::get, std::move(target));
+    }
+
+    /* Metered asynchronous private request */
+    net::awaitable<std::string> Connector::requestPrivateAsync(Network::HTTP::AsyncSession &session,
+                                                               Network::HTTP::Priority priority, char const *endpoint,
+                                                               http::verb method, std::string target, std::string body)
+    {
+        co_await this->privateLimiter_.asyncAcquire(priority, endpoint);
+        co_return co_await session.request(method, std::move(target), std::move(body));
+    }
+
+    /* Sends a cancellation on the warm cancel connections */
+    std::future<std::string> Connector::sendCancel(char const *endpoint, std::string target)
+    {
+        return net::co_spawn(
+            net::make_strand(this->ioc_),
+            Network::HTTP::asyncWithRetries(
+                this->retryPolicy_, true,
+                [this, endpoint, target = std::move(target)]
+                {
+                    return this->requestPrivateAsync(this->asyncCancelSession_, Network::HTTP::Priority::HIGH,
+                                                     endpoint, http::verb::delete_, target);
+                }),
+            net::use_future);
+    }
+
+    void Connector::stageOrder(
+        Orders::LimitOrder const &order,
+        Products::Product const *product,
+        Orders::StagedOrder &output)
+    {
+        OrderEncoder::encode(order, this->uniqueOrderId_++, product, output);
+    }
+
+    void Connector::stageOrder(
+        Orders::MarketOrder const &order,
+        Products::Product const *product,
+        Orders::StagedOrder &output)
+    {
+        OrderEncoder::encode(order, this->uniqueOrderId_++, product, output);
+    }
+
+    void Connector::stageOrder(Orders::LimitOrder const &order, Orders::StagedOrder &output)
+    {
+        // Rounded to the product's increments once its details are known (the catalogue outlives the call)
+        auto const catalogue = this->productCatalogue_ ? this->productCatalogue_->snapshot() : nullptr;
+        this->stageOrder(order, catalogue ? catalogue->lookup(order.productId_).get() : nullptr, output);
+    }
+
+    void Connector::stageOrder(Orders::MarketOrder const &order, Orders::StagedOrder &output)
+    {
+        // Rounded to the product's increments once its details are known (the catalogue outlives the call)
+        auto const catalogue = this->productCatalogue_ ? this->productCatalogue_->snapshot() : nullptr;
+        this->stageOrder(order, catalogue ? catalogue->lookup(order.productId_).get() : nullptr, output);
     }
 
     void Connector::placeOrder(
         Orders::LimitOrder const &order,
         Orders::OrderResponse &output)
     {
-        rapidjson::Document orderDocument;
-        orderDocument.SetObject();
-        auto orderAllocator = orderDocument.GetAllocator();
-
-        rapidjson::Value productIdValue(rapidjson::kObjectType);
-        productIdValue.SetString(order.productId_.c_str(), order.productId_.size(), orderAllocator);
-        orderDocument.AddMember("product_id", productIdValue, orderAllocator);
-
-        rapidjson::Value uniqueOrderIdValue(rapidjson::kObjectType);
-        std::string uniqueOrderIdString = std::to_string(this->uniqueOrderId_++);
-        uniqueOrderIdValue.SetString(uniqueOrderIdString.c_str(), uniqueOrderIdString.size(), orderAllocator);
-        orderDocument.AddMember("client_oid", uniqueOrderIdValue, orderAllocator);
-
-        orderDocument.AddMember("type", "limit", orderAllocator);
-
-        if (order.side_ == Orders::Side::BUY)
-            orderDocument.AddMember("side", "buy", orderAllocator);
-        else
-            orderDocument.AddMember("side", "sell", orderAllocator);
-
-        rapidjson::Value priceValue(rapidjson::kObjectType);
-        std::string priceString = std::to_string(order.price_);
-        priceValue.SetString(priceString.c_str(), priceString.size(), orderAllocator);
-        orderDocument.AddMember("price", priceValue, orderAllocator);
-
-        rapidjson::Value quantityValue(rapidjson::kObjectType);
-        std::string quantityString = std::to_string(order.quantity_);
-        quantityValue.SetString(quantityString.c_str(), quantityString.size(), orderAllocator);
-        orderDocument.AddMember("size", quantityValue, orderAllocator);
-
-        // Serialize to string
-        rapidjson::StringBuffer jsonStringBuffer;
-        rapidjson::Writer<rapidjson::StringBuffer> writer(jsonStringBuffer);
-        orderDocument.Accept(writer);
-
-        // Assign the message and post it
-        std::string orderBody = jsonStringBuffer.GetString();
-        std::string orderResponseString;
-        this->privateSession_.post("/orders", orderResponseString, orderBody);
-
-        this->parseOrderResponse(orderResponseString, output);
+        Orders::StagedOrder stagedOrder;
+        this->stageOrder(order, stagedOrder);
+        this->placeOrder(std::move(stagedOrder), output);
     }
 
     void Connector::placeOrder(
         Orders::MarketOrder const &order,
         Orders::OrderResponse &output)
     {
-        rapidjson::Document orderDocument;
-        orderDocument.SetObject();
-        auto orderAllocator = orderDocument.GetAllocator();
-
-        rapidjson::Value productIdValue(rapidjson::kObjectType);
-        productIdValue.SetString(order.productId_.c_str(), order.productId_.size(), orderAllocator);
-        orderDocument.AddMember("product_id", productIdValue, orderAllocator);
-
-        rapidjson::Value uniqueOrderIdValue(rapidjson::kObjectType);
-        std::string uniqueOrderIdString = std::to_string(this->uniqueOrderId_++);
-        uniqueOrderIdValue.SetString(uniqueOrderIdString.c_str(), uniqueOrderIdString.size(), orderAllocator);
-        orderDocument.AddMember("client_oid", uniqueOrderIdValue, orderAllocator);
-
-        orderDocument.AddMember("type", "market", orderAllocator);
-
-        if (order.side_ == Orders::Side::BUY)
-            orderDocument.AddMember("side", "buy", orderAllocator);
-        else
-            orderDocument.AddMember("side", "sell", orderAllocator);
-
-        rapidjson::Value quantityValue(rapidjson::kObjectType);
-        std::string quantityString = std::to_string(order.quantity_);
-        quantityValue.SetString(quantityString.c_str(), quantityString.size(), orderAllocator);
-        orderDocument.AddMember("size", quantityValue, orderAllocator);
-
-        // Serialize to string
-        rapidjson::StringBuffer jsonStringBuffer;
-        rapidjson::Writer<rapidjson::StringBuffer> writer(jsonStringBuffer);
-        orderDocument.Accept(writer);
-
-        // Assign the message
-        std::string orderBody = jsonStringBuffer.GetString();
-        std::string orderResponseString;
-        this->privateSession_.post("/orders", orderResponseString, orderBody);
-
-        this->parseOrderResponse(orderResponseString, output);
+        Orders::StagedOrder stagedOrder;
+        this->stageOrder(order, stagedOrder);
+        this->placeOrder(std::move(stagedOrder), output);
+    }
+
+    void Connector::placeOrder(
+        Orders::StagedOrder &&order,
+        Orders::OrderResponse &output)
+    {
+        order.consume();
+
+        // Post the order (signed as it is sent)
+        Network::HTTP::withRetries(
+            this->retryPolicy_, false,
+            [&]
+            {
+                this->privateLimiter_.acquire(Network::HTTP::Priority::HIGH, "POST /orders");
+                this->privatePool_.post(
+                    "/orders", order.body(),
+                    [&](std::span<char> response)
+                    { this->parseOrderResponse(response, output); });
+            });
+    }
+
+    void Connector::placeOrders(
+        std::span<Orders::StagedOrder> orders,
+        Orders::BatchResponse &output)
+    {
+        // Every order is consumed before the first one is sent, so that a batch is never sent in part
+        for (auto &order : orders)
+            if (order.isSent_ || order.bodySize_ == 0)
+                throw std::logic_error("Staged order " + std::to_string(order.clientOrderId_) + " was never staged or already sent");
+        for (auto &order : orders)
+            order.consume();
+
+        uint64_t const startTime = Utils::Datetime::epochNow<std::chrono::nanoseconds>();
+
+        // Fan every order out at once (the burst goes out together, the limiter paces the rest)
+        std::vector<std::future<std::string>> responses;
+        responses.reserve(orders.size());
+        for (auto const &order : orders)
+            responses.push_back(net::co_spawn(
+                net::make_strand(this->ioc_),
+                Network::HTTP::asyncWithRetries(
+                    this->retryPolicy_, false,
+                    [this, &order]
+                    {
+                        return this->requestPrivateAsync(this->asyncPrivateSession_, Network::HTTP::Priority::HIGH,
+                                                         "POST /orders", http::verb::post, "/orders",
+                                                         std::string(order.body()));
+                    }),
+                net::use_future));
+
+        // Collect the responses in the batch's order
+        output.responses_.clear();
+        output.responses_.resize(orders.size());
+        for (size_t i = 0; i < orders.size(); i++)
+        {
+            try
+            {
+                std::string response = responses[i].get();
+                this->parseOrderResponse(response, output.responses_[i]);
+            }
+            catch (std::exception const &e)
+            {
+                std::cerr << "Failed to place order " << orders[i].clientOrderId_ << ": " << e.what() << '\n';
+                output.responses_[i] = Orders::OrderResponse("", Orders::OrderResponse::Code::UNFORESEEN_FAILURE);
+            }
+        }
+
+        output.latency_ = Utils::Datetime::epochNow<std::chrono::nanoseconds>() - startTime;
     }
 
     void Connector::parseOrderResponse(
-        std::string const &orderResponseString,
+        std::span<char> orderResponse,
         Orders::OrderResponse &output)
     {
         /**
@@ -291,8 +372,7 @@ namespace CryptoConnect::CoinbasePro::REST
          *   'settled': False
          * }
          */
-        rapidjson::Document responseDocument;
-        responseDocument.Parse(orderResponseString.c_str());
+        auto &responseDocument = Utils::Json::Parser::local().parseInsitu(orderResponse);
 
         Orders::OrderResponse::Code orderResponseCode;
 
@@ -328,85 +408,67 @@ namespace CryptoConnect::CoinbasePro::REST
          */
 
         std::string target = "/orders/" + orderId;
-        std::string response;
-        this->privateSession_.isolatedGet(target.c_str(), response);
-
-        rapidjson::Document responseDocument;
-        responseDocument.Parse(response.c_str());
-
-        // If there is a message --> failed
-        if (responseDocument.HasMember("message"))
-        {
-            std::cerr << "Failed to get order " << orderId
-                      << " | Message: " << responseDocument["message"].GetString() << '\n';
-            return;
-        }
-
-        // Auto-cast cast as a rapidjson::Value object
-        this->parseOrderDetails(responseDocument, output);
+        Network::HTTP::withRetries(
+            this->retryPolicy_, true,
+            [&]
+            {
+                this->privateLimiter_.acquire(Network::HTTP::Priority::NORMAL, "GET /orders/{id}");
+                this->privatePool_.get(
+                    target.c_str(),
+                    [&](std::span<char> response)
+                    {
+                        auto &responseDocument = Utils::Json::Parser::local().parseInsitu(response);
+
+                        // If there is a message --> failed
+                        if (responseDocument.HasMember("message"))
+                        {
+                            std::cerr << "Failed to get order " << orderId
+                                      << " | Message: " << responseDocument["message"].GetString() << '\n';
+                            return;
+                        }
+
+                        Decoders::parseOrderDetails(responseDocument, output);
+                    });
+            });
     }
 
     void Connector::getAllOrders(
         Orders::Status const status,
         Orders::ordersDetails_t &output)
     {
-        /**
-         * https://docs.cloud.coinbase.com/exchange/reference/exchangerestapi_getorders
-         */
-
-        std::string target = "/orders";
-        switch (status)
-        {
-        case Orders::Status::RECEIVED:
-            target += "?status=received";
-            break;
-        case Orders::Status::OPEN:
-            target += "?status=open";
-            break;
-        case Orders::Status::DONE:
-            target += "?status=done";
-            break;
-            // Get all if unknown
-        }
-
-        std::string response;
-        this->privateSession_.get(target.c_str(), response);
-
-        rapidjson::Document responseDocument;
-        responseDocument.Parse(response.c_str());
-
-        // If it is an object --> failed
-        if (responseDocument.IsObject())
-        {
-            std::cerr << "Failed to get orders  | Message: "
-                      << responseDocument["message"].GetString() << '\n';
-            return;
-        }
-
-        if (!responseDocument.IsArray())
-        {
-            std::cerr << "Invalid response received " << responseDocument.GetString() << '\n';
-            return;
-        }
-
-        for (auto const &orderObj : responseDocument.GetArray())
-        {
-            // A little inefficient here (double construction)
-            output.emplace_back();
-            this->parseOrderDetails(orderObj, output.back());
-        }
+        this->getAllOrders("", status, output);
     }
 
     void Connector::getAllOrders(
         std::string const &productId,
         Orders::Status const status,
         Orders::ordersDetails_t &output)
+    {
+        this->getAllOrders(
+            productId, status,
+            [&output](Orders::ordersDetails_t const &page)
+            {
+                output.insert(output.end(), page.begin(), page.end());
+                return true;
+            });
+    }
+
+    void Connector::getAllOrders(
+        std::string const &productId,
+        Orders::Status const status,
+        Orders::ordersPageHandler_t const &handler)
     {
         /**
          * https://docs.cloud.coinbase.com/exchange/reference/exchangerestapi_getorders
+         *
+         * Paginated (newest first): the CB-AFTER header of a page
+         * is the cursor to request the next (older) one with.
          */
 
-        std::string target = "/orders?productId=" + productId;
+        std::string target = "/orders?limit=" + std::to_string(COINBASEPRO_REST_PAGE_SIZE);
+        if (!productId.empty())
+            target += "&product_id=" + productId;
+
         switch (status)
         {
         case Orders::Status::RECEIVED:
@@ -418,89 +480,48 @@ namespace CryptoConnect::CoinbasePro::REST
         case Orders::Status::DONE:
             target += "&status=done";
             break;
+        default:
             // Get all if unknown
+            target += "&status=all";
         }
 
-        std::string response;
-        this->privateSession_.get(target.c_str(), response);
+        // Only the page being handled and the one being fetched are ever held
+        Orders::ordersDetails_t page;
+        page.reserve(COINBASEPRO_REST_PAGE_SIZE);
 
-        rapidjson::Document responseDocument;
-        responseDocument.Parse(response.c_str());
-
-        // If it is an object --> failed
-        if (responseDocument.IsObject())
+        std::future<Network::HTTP::response_t> nextPage = this->getOrdersPage(target);
+        for (;;)
         {
-            std::cerr << "Failed to get orders | Message: "
-                      << responseDocument["message"].GetString() << '\n';
-            return;
-        }
+            Network::HTTP::response_t response = nextPage.get();
+            auto const after = response["CB-AFTER"];
+            std::string const cursor(after.data(), after.size());
 
-        if (!responseDocument.IsArray())
-        {
-            std::cerr << "Invalid response received " << responseDocument.GetString() << '\n';
-            return;
-        }
+            // Prefetch the next page while this one is decoded and handled
+            if (!cursor.empty())
+                nextPage = this->getOrdersPage(target + "&after=" + cursor);
 
-        for (auto const &orderObj : responseDocument.GetArray())
-        {
-            // A little inefficient here (double construction)
-            output.emplace_back();
-            this->parseOrderDetails(orderObj, output.back());
+            page.clear();
+            Decoders::parseOrdersDetails(response.body(), page);
+
+            // An unfinished prefetch is left to complete in the background
+            if (page.empty() || !handler(page) || cursor.empty())
+                return;
         }
     }
 
-    void Connector::parseOrderDetails(
-        rapidjson::Value const &obj,
-        Orders::OrderDetails &output)
+    /* Fetches a page of orders */
+    std::future<Network::HTTP::response_t> Connector::getOrdersPage(std::string target)
     {
-        /**
-         * https://docs.cloud.coinbase.com/exchange/reference/exchangerestapi_getorder
-         * 
-         * Note: Market orders have price = null
-         * 
-         * Sample Response:
-         * {
-         *   'id': 'c8c4effb-fb92-4413-8f03-af876f05757f',
-         *   'price': '49999',
-         *   'size': '0.00100000',
-         *   'product_id': 'BTC-USD',
-         *   'side': 'sell',
-         *   'type': 'limit',
-         *   'created_at': '2022-01-09T09:13:00.400937Z',
-         *   'fill_fees': '0.0000000000000000',
-         *   'filled_size': '0.00000000',
-         *   'executed_value': '0.0000000000000000',
-         *   'status': 'done',
-         *   'settled': False
-         * }
-         */
-
-        bool isMarket = std::string(obj["type"].GetString()) == "market";
-        std::string side = std::string(obj["side"].GetString());
-        std::string status = std::string(obj["status"].GetString());
-
-        output = Orders::OrderDetails(
-            obj["id"].GetString(),
-            isMarket
-                ? Orders::Type::MARKET
-                : Orders::Type::LIMIT,
-            side == "buy"
-                ? Orders::Side::BUY
-                : Orders::Side::SELL,
-            status == "open"
-                ? Orders::Status::OPEN
-                : (status == "done"
-                       ? Orders::Status::DONE
-                       : Orders::Status::UNKNOWN),
-            Utils::Datetime::isostringToEpoch<std::chrono::nanoseconds>(
-                obj["created_at"].GetString()),
-            obj["product_id"].GetString(),
-            isMarket
-                ? 0
-                : std::stod(obj["price"].GetString()),
-            std::stod(obj["size"].GetString()),
-            std::stod(obj["filled_size"].GetString()),
-            std::stod(obj["fill_fees"].GetString()));
+        return net::co_spawn(
+            net::make_strand(this->ioc_),
+            Network::HTTP::asyncWithRetries(
+                this->retryPolicy_, true,
+                [this, target = std::move(target)]() -> net::awaitable<Network::HTTP::response_t>
+                {
+                    co_await this->privateLimiter_.asyncAcquire(Network::HTTP::Priority::NORMAL, "GET /orders");
+                    co_return co_await this->asyncPrivateSession_.exchange(http::verb::get, target);
+                }),
+            net::use_future);
     }
 
     bool Connector::cancelOrder(std::string const &orderId)
@@ -512,15 +533,42 @@ namespace CryptoConnect::CoinbasePro::REST
          * "c8c4effb-fb92-4413-8f03-af876f05757f"
          */
 
-        std::string target = "/orders/" + orderId;
-        std::string response;
-        this->privateSession_.isolatedDel(target.c_str(), response);
+        std::string response = this->sendCancel("DELETE /orders/{id}", "/orders/" + orderId).get();
+        return this->parseCancelResponse(orderId, response);
+    }
 
-        rapidjson::Document responseDocument;
-        responseDocument.Parse(response.c_str());
+    void Connector::cancelOrders(
+        Orders::orderIds_t const &orderIds,
+        Orders::orderIds_t &output)
+    {
+        // Dispatch every cancellation at once
+        std::vector<std::future<std::string>> responses;
+        responses.reserve(orderIds.size());
+        for (auto const &orderId : orderIds)
+            responses.push_back(this->sendCancel("DELETE /orders/{id}", "/orders/" + orderId));
+
+        // Confirm them one by one
+        for (size_t i = 0; i < orderIds.size(); i++)
+        {
+            try
+            {
+                std::string response = responses[i].get();
+                if (this->parseCancelResponse(orderIds[i], response))
+                    output.push_back(orderIds[i]);
+            }
+            catch (std::exception const &e)
+            {
+                std::cerr << "Failed to cancel order " << orderIds[i] << ": " << e.what() << '\n';
+            }
+        }
+    }
+
+    bool Connector::parseCancelResponse(std::string const &orderId, std::span<char> response)
+    {
+        auto &responseDocument = Utils::Json::Parser::local().parseInsitu(response);
 
         // If there is a message --> failed
-        if (responseDocument.HasMember("message"))
+        if (responseDocument.IsObject() && responseDocument.HasMember("message"))
         {
             std::cerr << "Failed to cancel order " << orderId
                       << " | Message: " << responseDocument["message"].GetString() << '\n';
@@ -541,30 +589,8 @@ namespace CryptoConnect::CoinbasePro::REST
          *   '55d0ee7d-c3cc-4df0-835e-eabd6d369de6'
          * ]
          */
-        std::string response;
-        this->privateSession_.del("/orders", response);
-
-        rapidjson::Document responseDocument;
-        responseDocument.Parse(response.c_str());
-
-        // If it is an object --> failed
-        if (responseDocument.IsObject())
-        {
-            std::cerr << "Failed to get orders | Message: "
-                      << responseDocument["message"].GetString() << '\n';
-            return;
-        }
-
-        if (!responseDocument.IsArray())
-        {
-            std::cerr << "Invalid response received " << responseDocument.GetString() << '\n';
-            return;
-        }
-
-        for (auto const &orderIdObj : responseDocument.GetArray())
-        {
-            output.emplace_back(orderIdObj.GetString());
-        }
+        std::string response = this->sendCancel("DELETE /orders", "/orders").get();
+        Decoders::parseOrderIds(response, output);
     }
 
     void Connector::cancelAllOrders(
@@ -580,28 +606,32 @@ namespace CryptoConnect::CoinbasePro::REST
          * ]
          */
 
-        std::string target = "/orders?productId=" + productId;
-        std::string response;
-        this->privateSession_.isolatedDel(target.c_str(), response);
-
-        rapidjson::Document responseDocument;
-        responseDocument.Parse(response.c_str());
-
-        // If is is an object --> failed
-        if (responseDocument.IsObject())
-        {
-            std::cerr << "Failed to get orders | Message: "
-                      << responseDocument["message"].GetString() << '\n';
-            return;
-        }
+        std::string response = this->sendCancel("DELETE /orders", "/orders?product_id=" + productId).get();
+        Decoders::parseOrderIds(response, output);
+    }
 
-        if (!responseDocument.IsArray())
+    void Connector::cancelAllOrders(
+        std::span<std::string const> productIds,
+        Orders::orderIds_t &output)
+    {
+        // Dispatch every product's cancellation at once
+        std::vector<std::future<std::string>> responses;
+        responses.reserve(productIds.size());
+        for (auto const &productId : productIds)
+            responses.push_back(this->sendCancel("DELETE /orders", "/orders?product_id=" + productId));
+
+        // Gather the cancelled IDs
+        for (size_t i = 0; i < productIds.size(); i++)
         {
-            std::cerr << "Invalid response received " << responseDocument.GetString() << '\n';
-            return;
+            try
+            {
+                std::string response = responses[i].get();
+                Decoders::parseOrderIds(response, output);
+            }
+            catch (std::exception const &e)
+            {
+                std::cerr << "Failed to cancel the orders of " << productIds[i] << ": " << e.what() << '\n';
+            }
         }
-
-        for (auto const &orderIdObj : responseDocument.GetArray())
-            output.emplace_back(orderIdObj.GetString());
     }
 }
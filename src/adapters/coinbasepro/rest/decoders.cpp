@@ -0,0 +1,220 @@
+#include "cryptoconnect/adapters/coinbasepro/rest/decoders.hpp"
+
+#include "cryptoconnect/helpers/utils/datetime.hpp"
+#include "cryptoconnect/helpers/utils/json.hpp"
+#include "cryptoconnect/structs/events.hpp"
+#include "cryptoconnect/structs/orders.hpp"
+#include "cryptoconnect/structs/products.hpp"
+
+#include <rapidjson/document.h>
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace CryptoConnect::CoinbasePro::REST::Decoders
+{
+    namespace
+    {
+        /* Lookup tables for the order fields the exchange sends as strings */
+        constexpr std::pair<std::string_view, Orders::Type> c_orderTypes[] = {
+            {"limit", Orders::Type::LIMIT},
+            {"market", Orders::Type::MARKET}};
+
+        constexpr std::pair<std::string_view, Orders::Side> c_orderSides[] = {
+            {"buy", Orders::Side::BUY},
+            {"sell", Orders::Side::SELL}};
+
+        constexpr std::pair<std::string_view, Orders::Status> c_orderStatuses[] = {
+            {"open", Orders::Status::OPEN},
+            {"done", Orders::Status::DONE},
+            {"pending", Orders::Status::RECEIVED},
+            {"received", Orders::Status::RECEIVED},
+            {"active", Orders::Status::OPEN}};
+
+        /* Looks the string value up in the table (the fallback if absent) */
+        template <typename Enum, size_t N>
+        Enum lookup(std::pair<std::string_view, Enum> const (&table)[N], rapidjson::Value const &value, Enum fallback)
+        {
+            std::string_view const key = Utils::Json::view(value);
+            for (auto const &[name, enumValue] : table)
+                if (name == key)
+                    return enumValue;
+            return fallback;
+        }
+
+        /* Decodes an order's fields straight into the constructor of its details (called by emplace) */
+        template <typename Emplace>
+        void decodeOrderDetails(rapidjson::Value const &obj, Emplace emplace)
+        {
+            /**
+             * https://docs.cloud.coinbase.com/exchange/reference/exchangerestapi_getorder
+             * 
+             * Note: Market orders have price = null
+             * 
+             * Sample Response:
+             * {
+             *   'id': 'c8c4effb-fb92-4413-8f03-af876f05757f',
+             *   'price': '49999',
+             *   'size': '0.00100000',
+             *   'product_id': 'BTC-USD',
+             *   'side': 'sell',
+             *   'type': 'limit',
+             *   'created_at': '2022-01-09T09:13:00.400937Z',
+             *   'fill_fees': '0.0000000000000000',
+             *   'filled_size': '0.00000000',
+             *   'executed_value': '0.0000000000000000',
+             *   'status': 'done',
+             *   'settled': False
+             * }
+             */
+
+            Orders::Type const type = lookup(c_orderTypes, obj["type"], Orders::Type::LIMIT);
+            bool const isMarket = type == Orders::Type::MARKET;
+
+            emplace(
+                std::string(Utils::Json::view(obj["id"])),
+                type,
+                lookup(c_orderSides, obj["side"], Orders::Side::UNKONWN),
+                lookup(c_orderStatuses, obj["status"], Orders::Status::UNKNOWN),
+                Utils::Datetime::isostringToEpoch<std::chrono::nanoseconds>(
+                    Utils::Json::view(obj["created_at"])),
+                std::string(Utils::Json::view(obj["product_id"])),
+                isMarket
+                    ? 0
+                    : Utils::Json::toDouble(obj["price"]),
+                Utils::Json::toDouble(obj["size"]),
+                Utils::Json::toDouble(obj["filled_size"]),
+                Utils::Json::toDouble(obj["fill_fees"]));
+        }
+    }
+
+    void parseProducts(std::span<char> response, Products::productMap_t &productMapOutput)
+    {
+        // Parse the JSON response in place
+        auto &symbolsDocument = Utils::Json::Parser::local().parseInsitu(response);
+
+        if (symbolsDocument.HasParseError() || !symbolsDocument.IsArray())
+            throw std::runtime_error("Unparsable products response");
+
+        // Clear the existing product map
+        // Shared pointers will de-allocate since map is no longer pointing to it
+        productMapOutput.clear();
+        productMapOutput.reserve(symbolsDocument.Size());
+
+        // Iterate and emplace into the output obj
+        for (auto const &productDetailsObj : symbolsDocument.GetArray())
+        {
+            std::string productId(Utils::Json::view(productDetailsObj["id"]));
+
+            auto productPtr = std::make_shared<Products::Product>(
+                productId,
+                std::string(Utils::Json::view(productDetailsObj["display_name"])),
+                std::string(Utils::Json::view(productDetailsObj["base_currency"])),
+                std::string(Utils::Json::view(productDetailsObj["quote_currency"])),
+                Utils::Json::toDouble(productDetailsObj["base_min_size"]),
+                Utils::Json::toDouble(productDetailsObj["base_max_size"]),
+                Utils::Json::toDouble(productDetailsObj["base_increment"]),
+                Utils::Json::toDouble(productDetailsObj["quote_increment"]),
+                productDetailsObj.HasMember("trading_disabled")
+                    ? !productDetailsObj["trading_disabled"].GetBool()
+                    : true,
+                productDetailsObj["margin_enabled"].GetBool());
+
+            // Register the product
+            productMapOutput.insert_or_assign(std::move(productId), std::move(productPtr));
+        }
+    }
+
+    void parseBars(std::string const &productId, std::span<char> response, Events::bars_t &output)
+    {
+        auto &document = Utils::Json::Parser::local().parseInsitu(response);
+
+        if (document.HasParseError() || !document.IsArray())
+        {
+            std::cerr << "No bars received for " << productId << " | "
+                      << (document.HasParseError() ? "unparsable response" : Utils::Json::stringify(document)) << '\n';
+            return;
+        }
+
+        // Sized on the first page only, later pages grow geometrically
+        if (output.empty())
+            output.reserve(document.Size());
+        for (auto const &barJson : document.GetArray())
+            output.emplace_back(
+                barJson[0].GetUint64() * 1000000000, // epoch time in nanoseconds
+                productId,                           // productId
+                barJson[3].GetDouble(),              // open
+                barJson[2].GetDouble(),              // high
+                barJson[1].GetDouble(),              // low
+                barJson[4].GetDouble(),              // close
+                barJson[5].GetDouble()               // volume
+            );
+    }
+
+    void parseOrderDetails(rapidjson::Value const &obj, Orders::OrderDetails &output)
+    {
+        decodeOrderDetails(
+            obj,
+            [&output](auto &&...fields)
+            { output = Orders::OrderDetails(std::forward<decltype(fields)>(fields)...); });
+    }
+
+    void parseOrdersDetails(std::span<char> response, Orders::ordersDetails_t &output)
+    {
+        auto &responseDocument = Utils::Json::Parser::local().parseInsitu(response);
+
+        // If it is an object --> failed
+        if (responseDocument.IsObject())
+        {
+            std::cerr << "Failed to get orders | Message: "
+                      << responseDocument["message"].GetString() << '\n';
+            return;
+        }
+
+        if (!responseDocument.IsArray())
+        {
+            std::cerr << "Invalid response received " << Utils::Json::stringify(responseDocument) << '\n';
+            return;
+        }
+
+        // Constructed straight into the output (sized on the first page only, later pages grow geometrically)
+        if (output.empty())
+            output.reserve(responseDocument.Size());
+        for (auto const &orderObj : responseDocument.GetArray())
+            decodeOrderDetails(
+                orderObj,
+                [&output](auto &&...fields)
+                { output.emplace_back(std::forward<decltype(fields)>(fields)...); });
+    }
+
+    void parseOrderIds(std::span<char> response, Orders::orderIds_t &output)
+    {
+        auto &responseDocument = Utils::Json::Parser::local().parseInsitu(response);
+
+        // If it is an object --> failed
+        if (responseDocument.IsObject())
+        {
+            std::cerr << "Failed to cancel orders | Message: "
+                      << responseDocument["message"].GetString() << '\n';
+            return;
+        }
+
+        if (!responseDocument.IsArray())
+        {
+            std::cerr << "Invalid response received " << Utils::Json::stringify(responseDocument) << '\n';
+            return;
+        }
+
+        // Sized on the first page only, later pages grow geometrically
+        if (output.empty())
+            output.reserve(responseDocument.Size());
+        for (auto const &orderIdObj : responseDocument.GetArray())
+            output.emplace_back(Utils::Json::view(orderIdObj));
+    }
+}
@@ -0,0 +1,185 @@
+#include "cryptoconnect/adapters/coinbasepro/rest/history_downloader.hpp"
+
+#include "cryptoconnect/helpers/network/http/rate_limiter.hpp"
+#include "cryptoconnect/helpers/network/http/retry_policy.hpp"
+#include "cryptoconnect/helpers/utils/datetime.hpp"
+#include "cryptoconnect/helpers/utils/json.hpp"
+#include "cryptoconnect/structs/events.hpp"
+#include "cryptoconnect/adapters/coinbasepro/rest/connector.hpp"
+
+#include <boost/asio/use_future.hpp>
+#include <rapidjson/document.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <future>
+#include <iostream>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace CryptoConnect::CoinbasePro::REST
+{
+    namespace
+    {
+        /* Row of a window, gathered before being laid out as columns */
+        struct Candle
+        {
+            uint64_t epochTime_;
+            double open_, high_, low_, close_, vol_;
+        };
+
+        /* Window being fetched */
+        struct Window
+        {
+            size_t rangeIndex_;
+            uint64_t start_;
+            std::future<std::string> response_;
+        };
+    }
+
+    void HistoryDownloader::download(
+        std::span<std::string const> productIds,
+        uint64_t granularity,
+        uint64_t start,
+        uint64_t end,
+        Events::barSeriesMap_t &output)
+    {
+        std::vector<Range> ranges;
+        ranges.reserve(productIds.size());
+        for (auto const &productId : productIds)
+            ranges.emplace_back(productId, start, end);
+
+        this->download(ranges, granularity);
+
+        for (auto &range : ranges)
+            output[range.productId_] = std::move(range.bars_);
+    }
+
+    void HistoryDownloader::download(std::span<Range> ranges, uint64_t granularity)
+    {
+        // Guard clause for an empty granularity
+        if (!granularity)
+            return;
+
+        uint64_t const windowSpan = COINBASEPRO_HISTORY_WINDOW_BARS * granularity;
+
+        // Sized once a range's first window comes in, the rest grow geometrically
+        std::vector<std::vector<Candle>> candles(ranges.size());
+
+        // Parses a window's response (newest bars first) onto its range's candles
+        auto collect = [&](Window &window)
+        {
+            Range &range = ranges[window.rangeIndex_];
+            try
+            {
+                std::string response = window.response_.get();
+                auto &document = Utils::Json::Parser::local().parseInsitu(response);
+
+                if (document.HasParseError() || !document.IsArray())
+                {
+                    std::cerr << "No bars received for " << range.productId_ << " from "
+                              << Utils::Datetime::epochToIsostring(window.start_) << '\n';
+                    range.isComplete_ = false;
+                    return;
+                }
+
+                // Bars expected in the range, capped at what the windows in flight hold at once
+                auto &rangeCandles = candles[window.rangeIndex_];
+                if (rangeCandles.capacity() == 0)
+                    rangeCandles.reserve(std::min<uint64_t>(
+                        (range.end_ - range.start_) / granularity + 1,
+                        COINBASEPRO_HISTORY_WINDOW_BARS * COINBASEPRO_HISTORY_MAX_IN_FLIGHT));
+                for (auto const &barJson : document.GetArray())
+                    rangeCandles.push_back(Candle{
+                        barJson[0].GetUint64() * 1000000000, // epoch time in nanoseconds
+                        barJson[3].GetDouble(),              // open
+                        barJson[2].GetDouble(),              // high
+                        barJson[1].GetDouble(),              // low
+                        barJson[4].GetDouble(),              // close
+                        barJson[5].GetDouble()});            // volume
+            }
+            catch (std::exception const &e)
+            {
+                std::cerr << "Failed to download the bars of " << range.productId_ << " from "
+                          << Utils::Datetime::epochToIsostring(window.start_) << ": " << e.what() << '\n';
+                range.isComplete_ = false;
+            }
+        };
+
+        // Keep a bounded number of windows in flight, collecting the oldest one to make room
+        std::deque<Window> inFlight;
+        for (size_t i = 0; i < ranges.size(); i++)
+        {
+            Range const &range = ranges[i];
+            for (uint64_t windowStart = range.start_; windowStart <= range.end_; windowStart += windowSpan)
+            {
+                if (inFlight.size() >= COINBASEPRO_HISTORY_MAX_IN_FLIGHT)
+                {
+                    collect(inFlight.front());
+                    inFlight.pop_front();
+                }
+
+                uint64_t const windowEnd = std::min(windowStart + windowSpan - granularity, range.end_);
+                inFlight.push_back(Window{i, windowStart, this->fetchWindow(range.productId_, granularity, windowStart, windowEnd)});
+            }
+        }
+
+        while (!inFlight.empty())
+        {
+            collect(inFlight.front());
+            inFlight.pop_front();
+        }
+
+        // Order, de-duplicate (windows may share their edges) and lay out as columns
+        for (size_t i = 0; i < ranges.size(); i++)
+        {
+            auto &rangeCandles = candles[i];
+            std::sort(rangeCandles.begin(), rangeCandles.end(),
+                      [](Candle const &a, Candle const &b)
+                      { return a.epochTime_ < b.epochTime_; });
+            rangeCandles.erase(
+                std::unique(rangeCandles.begin(), rangeCandles.end(),
+                            [](Candle const &a, Candle const &b)
+                            { return a.epochTime_ == b.epochTime_; }),
+                rangeCandles.end());
+
+            Events::BarSeries &series = ranges[i].bars_;
+            series = Events::BarSeries();
+            series.reserve(rangeCandles.size());
+            for (auto const &candle : rangeCandles)
+                series.append(candle.epochTime_, candle.open_, candle.high_,
+                              candle.low_, candle.close_, candle.vol_);
+
+            // Release each range's rows once laid out
+            std::vector<Candle>().swap(rangeCandles);
+        }
+    }
+
+    /* Fetches a window of raw bars */
+    std::future<std::string> HistoryDownloader::fetchWindow(
+        std::string const &productId,
+        uint64_t granularity,
+        uint64_t start,
+        uint64_t end)
+    {
+        std::string target = "/products/" + productId + "/candles?granularity=" + std::to_string(granularity) +
+                             "&start=" + Utils::Datetime::epochToIsostring(start) +
+                             "&end=" + Utils::Datetime::epochToIsostring(end);
+
+        REST::Connector *restConnector = this->restConnector_;
+        return net::co_spawn(
+            net::make_strand(restConnector->ioc_),
+            Network::HTTP::asyncWithRetries(
+                restConnector->retryPolicy_, true,
+                [restConnector, target = std::move(target)]
+                {
+                    return restConnector->getPublicAsync(
+                        Network::HTTP::Priority::LOW, "GET /products/candles", target);
+                }),
+            net::use_future);
+    }
+}
@@ -0,0 +1,169 @@
+#include "cryptoconnect/adapters/coinbasepro/rest/order_encoder.hpp"
+
+#include "cryptoconnect/structs/orders.hpp"
+#include "cryptoconnect/structs/products.hpp"
+
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+namespace CryptoConnect::CoinbasePro::REST
+{
+    namespace
+    {
+        /* Rounds to the increment (nearest or down), tolerating the representation error of an exact multiple when rounding down */
+        double roundToIncrement(double value, double increment, bool isRoundedDown)
+        {
+            double const steps = isRoundedDown
+                                     ? std::floor(value / increment + 1e-9)
+                                     : std::round(value / increment);
+            return steps * increment;
+        }
+
+        /* Shortest round-trip text of a number for the error messages */
+        std::string toString(double value)
+        {
+            char text[32];
+            return std::string(text, std::to_chars(text, text + sizeof(text), value).ptr);
+        }
+
+        /* Throws std::invalid_argument if the size rounds to nothing or below the product's minimum */
+        void checkSize(double size, Products::Product const *product)
+        {
+            double const roundedSize = product && product->baseIncrement_ > 0
+                                           ? roundToIncrement(size, product->baseIncrement_, true)
+                                           : size;
+
+            if (!(roundedSize > 0))
+                throw std::invalid_argument("Order size " + toString(size) + " rounds to zero");
+            // Tolerate the representation error of a size right at the minimum
+            if (product && roundedSize < product->baseMinSize_ * (1 - 1e-9))
+                throw std::invalid_argument("Order size " + toString(size) + " is below the minimum of " +
+                                            product->id_ + " (" + toString(product->baseMinSize_) + ")");
+        }
+
+        /* Appends onto the staged order's body, never past its end */
+        class BodyWriter
+        {
+        private:
+            char *cursor_;
+            char *end_;
+            Orders::StagedOrder &output_;
+
+        public:
+            BodyWriter(Orders::StagedOrder &output)
+                : cursor_(output.body_.data()), end_(output.body_.data() + output.body_.size()), output_(output){};
+
+            void append(std::string_view text)
+            {
+                if (text.size() > static_cast<size_t>(this->end_ - this->cursor_))
+                    throw std::length_error("Order body exceeds ORDERS_STAGED_BODY_SIZE");
+
+                std::memcpy(this->cursor_, text.data(), text.size());
+                this->cursor_ += text.size();
+            }
+
+            void append(Orders::clientOrderId_t value)
+            {
+                this->check(std::to_chars(this->cursor_, this->end_, value));
+            }
+
+            /* Rounded to the increment (nearest or down) and printed with its decimals, in full without one */
+            void append(double value, double increment, bool isRoundedDown)
+            {
+                if (increment <= 0)
+                    return this->check(std::to_chars(this->cursor_, this->end_, value, std::chars_format::fixed));
+
+                this->check(std::to_chars(this->cursor_, this->end_, roundToIncrement(value, increment, isRoundedDown),
+                                          std::chars_format::fixed, OrderEncoder::decimals(increment)));
+            }
+
+            /* Records the body's size */
+            void finish() { this->output_.bodySize_ = this->cursor_ - this->output_.body_.data(); }
+
+        private:
+            void check(std::to_chars_result const result)
+            {
+                if (result.ec != std::errc())
+                    throw std::length_error("Order body exceeds ORDERS_STAGED_BODY_SIZE");
+                this->cursor_ = result.ptr;
+            }
+        };
+
+        /* Fields shared by every order type */
+        void encodeHeader(BodyWriter &writer, std::string const &productId,
+                          Orders::clientOrderId_t const clientOrderId,
+                          std::string_view type, Orders::Side const side)
+        {
+            writer.append("{\"product_id\":\"");
+            writer.append(productId);
+            writer.append("\",\"client_oid\":\"");
+            writer.append(clientOrderId);
+            writer.append("\",\"type\":\"");
+            writer.append(type);
+            writer.append(side == Orders::Side::BUY
+                              ? "\",\"side\":\"buy\""
+                              : "\",\"side\":\"sell\"");
+        }
+    }
+
+    void OrderEncoder::encode(
+        Orders::LimitOrder const &order,
+        Orders::clientOrderId_t const clientOrderId,
+        Products::Product const *product,
+        Orders::StagedOrder &output)
+    {
+        checkSize(order.quantity_, product);
+
+        output.clientOrderId_ = clientOrderId;
+        output.productId_ = order.productId_;
+        output.isSent_ = false;
+
+        BodyWriter writer(output);
+        encodeHeader(writer, order.productId_, clientOrderId, "limit", order.side_);
+
+        writer.append(",\"price\":\"");
+        writer.append(order.price_, product ? product->quoteIncrement_ : 0, false);
+        writer.append("\",\"size\":\"");
+        writer.append(order.quantity_, product ? product->baseIncrement_ : 0, true);
+        writer.append("\"}");
+        writer.finish();
+    }
+
+    void OrderEncoder::encode(
+        Orders::MarketOrder const &order,
+        Orders::clientOrderId_t const clientOrderId,
+        Products::Product const *product,
+        Orders::StagedOrder &output)
+    {
+        checkSize(order.quantity_, product);
+
+        output.clientOrderId_ = clientOrderId;
+        output.productId_ = order.productId_;
+        output.isSent_ = false;
+
+        BodyWriter writer(output);
+        encodeHeader(writer, order.productId_, clientOrderId, "market", order.side_);
+
+        writer.append(",\"size\":\"");
+        writer.append(order.quantity_, product ? product->baseIncrement_ : 0, true);
+        writer.append("\"}");
+        writer.finish();
+    }
+
+    int OrderEncoder::decimals(double increment)
+    {
+        // Scale until whole (increments are powers of ten or multiples of them, 1e-16 at the finest)
+        int decimals = 0;
+        for (double scaled = increment;
+             decimals < 16 && std::abs(scaled - std::round(scaled)) > scaled * 1e-9;
+             scaled *= 10)
+            decimals++;
+
+        return decimals;
+    }
+}
@@ -0,0 +1,232 @@
+#include "cryptoconnect/adapters/coinbasepro/rest/order_gateway.hpp"
+
+#include "cryptoconnect/helpers/network/http/session.hpp"
+#include "cryptoconnect/helpers/utils/datetime.hpp"
+#include "cryptoconnect/structs/events.hpp"
+#include "cryptoconnect/structs/orders.hpp"
+#include "cryptoconnect/adapters/coinbasepro/auth.hpp"
+#include "cryptoconnect/adapters/coinbasepro/rest/connector.hpp"
+
+#include <boost/asio/post.hpp>
+
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <mutex>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace CryptoConnect::CoinbasePro::REST
+{
+    /* Constructor */
+    OrderGateway::OrderGateway(REST::Connector *restConnector, Auth *auth, Events::Queue *eventQueue)
+        : restConnector_(restConnector), eventQueue_(eventQueue)
+    {
+        // Add the auth request decorator to the gateway sessions
+        this->sessionPool_.addRequestDecorator(
+            [auth](Network::HTTP::request_t &req)
+            { auth->addAuthHeaders(req); });
+
+        // Have a connection per thread ready for the first orders and keep them warm
+        this->sessionPool_.warmUp(ORDER_GATEWAY_THREADS);
+        this->sessionPool_.keepAlive(
+            std::chrono::seconds(COINBASEPRO_REST_KEEPALIVE_S), "/time", ORDER_GATEWAY_THREADS,
+            &this->restConnector_->privateLimiter_);
+    }
+
+    /* Stages the order on the caller's thread and queues it to be sent */
+    template <typename Order>
+    Orders::clientOrderId_t OrderGateway::stageAndSubmit(Order const &order)
+    {
+        // Encode on the caller's thread so that the order is captured as it is now
+        Orders::StagedOrder stagedOrder;
+        this->restConnector_->stageOrder(order, stagedOrder);
+        return this->submitOrder(std::move(stagedOrder));
+    }
+
+    /* Queues the limit order to be sent */
+    Orders::clientOrderId_t OrderGateway::submitOrder(Orders::LimitOrder const &order)
+    {
+        return this->stageAndSubmit(order);
+    }
+
+    /* Queues the market order to be sent */
+    Orders::clientOrderId_t OrderGateway::submitOrder(Orders::MarketOrder const &order)
+    {
+        return this->stageAndSubmit(order);
+    }
+
+    /* Queues the staged order to be sent */
+    Orders::clientOrderId_t OrderGateway::submitOrder(Orders::StagedOrder &&order)
+    {
+        order.consume();
+        Orders::clientOrderId_t const clientOrderId = order.clientOrderId_;
+        uint64_t const submitTime = Utils::Datetime::epochNow<std::chrono::nanoseconds>();
+
+        // Tracked before it can be sent for cancellations to be held back until it is acknowledged
+        {
+            std::lock_guard<std::mutex> lock(this->trackedOrdersMutex_);
+            this->trackedOrders_[clientOrderId] = TrackedOrder();
+            // Lock guard goes out of scope and releases
+        }
+
+        boost::asio::post(
+            this->threadPool_,
+            [this, order = std::move(order), submitTime]
+            { this->sendOrder(order, submitTime); });
+
+        return clientOrderId;
+    }
+
+    /* Queues the cancellation to be sent */
+    Orders::clientOrderId_t OrderGateway::cancelOrder(Orders::orderId_t const &orderId)
+    {
+        uint64_t const submitTime = Utils::Datetime::epochNow<std::chrono::nanoseconds>();
+        Orders::clientOrderId_t const clientOrderId = this->restConnector_->uniqueOrderId_++;
+
+        this->postCancel(orderId, clientOrderId, submitTime);
+        return clientOrderId;
+    }
+
+    /* Queues the cancellation of an order submitted through the gateway */
+    Orders::clientOrderId_t OrderGateway::cancelOrder(Orders::clientOrderId_t const orderClientOrderId)
+    {
+        uint64_t const submitTime = Utils::Datetime::epochNow<std::chrono::nanoseconds>();
+        Orders::clientOrderId_t const clientOrderId = this->restConnector_->uniqueOrderId_++;
+
+        Orders::orderId_t orderId;
+        {
+            std::lock_guard<std::mutex> lock(this->trackedOrdersMutex_);
+            auto const trackedOrder = this->trackedOrders_.find(orderClientOrderId);
+
+            if (trackedOrder != this->trackedOrders_.end())
+            {
+                // Guard clause for a submission still on its way (released along with its acknowledgement)
+                if (!trackedOrder->second.isAcked_)
+                {
+                    trackedOrder->second.queuedCancels_.push_back(QueuedCancel{clientOrderId, submitTime});
+                    return clientOrderId;
+                }
+
+                orderId = std::move(trackedOrder->second.orderId_);
+                this->trackedOrders_.erase(trackedOrder);
+            }
+            // Lock guard goes out of scope and releases
+        }
+
+        // Guard clause for orders rejected, dropped from the tracking or never submitted through the gateway
+        if (orderId.empty())
+        {
+            std::cerr << "Failed to cancel order with client order ID " << orderClientOrderId
+                      << ": no order ID to cancel" << '\n';
+            this->eventQueue_->enqueue<Events::CancelAck>(clientOrderId, submitTime, "", false, 0);
+            return clientOrderId;
+        }
+
+        this->postCancel(std::move(orderId), clientOrderId, submitTime);
+        return clientOrderId;
+    }
+
+    /* Sends a staged order, enqueues its acknowledgement and releases the cancellations held back */
+    void OrderGateway::sendOrder(Orders::StagedOrder const &order, uint64_t const submitTime)
+    {
+        Orders::OrderResponse orderResponse;
+        try
+        {
+            Network::HTTP::withRetries(
+                this->restConnector_->retryPolicy_, false,
+                [&]
+                {
+                    this->restConnector_->privateLimiter_.acquire(Network::HTTP::Priority::HIGH, "POST /orders");
+                    this->sessionPool_.post(
+                        "/orders", order.body(),
+                        [&](std::span<char> response)
+                        { this->restConnector_->parseOrderResponse(response, orderResponse); });
+                });
+        }
+        catch (std::exception const &e)
+        {
+            std::cerr << "Failed to send order " << order.clientOrderId_ << ": " << e.what() << '\n';
+            orderResponse = Orders::OrderResponse("", Orders::OrderResponse::Code::UNFORESEEN_FAILURE);
+        }
+
+        bool const isPlaced = orderResponse.code_ == Orders::OrderResponse::Code::SUCCESS;
+
+        // Keep the exchange's order ID for later cancellations, release the ones that came in the meantime
+        std::vector<QueuedCancel> queuedCancels;
+        {
+            std::lock_guard<std::mutex> lock(this->trackedOrdersMutex_);
+            auto const trackedOrder = this->trackedOrders_.find(order.clientOrderId_);
+            if (trackedOrder != this->trackedOrders_.end())
+            {
+                queuedCancels = std::move(trackedOrder->second.queuedCancels_);
+
+                if (isPlaced && queuedCancels.empty())
+                {
+                    trackedOrder->second.isAcked_ = true;
+                    trackedOrder->second.orderId_ = orderResponse.id_;
+                    this->ackedOrders_.push_back(order.clientOrderId_);
+                }
+                else
+                    this->trackedOrders_.erase(trackedOrder);
+            }
+
+            // Only the most recent acknowledgements stay cancellable by client order ID
+            while (this->ackedOrders_.size() > ORDER_GATEWAY_TRACKED_ORDERS)
+            {
+                this->trackedOrders_.erase(this->ackedOrders_.front());
+                this->ackedOrders_.pop_front();
+            }
+            // Lock guard goes out of scope and releases
+        }
+
+        uint64_t const now = Utils::Datetime::epochNow<std::chrono::nanoseconds>();
+        this->eventQueue_->enqueue<Events::OrderAck>(
+            order.clientOrderId_, now, order.productId_, orderResponse, now - submitTime);
+
+        for (auto const &queuedCancel : queuedCancels)
+        {
+            if (isPlaced)
+                this->postCancel(orderResponse.id_, queuedCancel.clientOrderId_, queuedCancel.submitTime_);
+            else
+                this->eventQueue_->enqueue<Events::CancelAck>(
+                    queuedCancel.clientOrderId_, now, "", false, now - queuedCancel.submitTime_);
+        }
+    }
+
+    /* Queues a cancellation to be sent on the gateway's threads */
+    void OrderGateway::postCancel(Orders::orderId_t orderId, Orders::clientOrderId_t const clientOrderId,
+                                  uint64_t const submitTime)
+    {
+        boost::asio::post(
+            this->threadPool_,
+            [this, clientOrderId, orderId = std::move(orderId), submitTime]
+            {
+                bool isCancelled = false;
+                try
+                {
+                    std::string target = "/orders/" + orderId;
+                    Network::HTTP::withRetries(
+                        this->restConnector_->retryPolicy_, true,
+                        [&]
+                        {
+                            this->restConnector_->privateLimiter_.acquire(Network::HTTP::Priority::HIGH, "DELETE /orders/{id}");
+                            this->sessionPool_.del(
+                                target.c_str(),
+                                [&](std::span<char> response)
+                                { isCancelled = this->restConnector_->parseCancelResponse(orderId, response); });
+                        });
+                }
+                catch (std::exception const &e)
+                {
+                    std::cerr << "Failed to send the cancellation of order " << orderId << ": " << e.what() << '\n';
+                }
+
+                uint64_t const now = Utils::Datetime::epochNow<std::chrono::nanoseconds>();
+                this->eventQueue_->enqueue<Events::CancelAck>(
+                    clientOrderId, now, orderId, isCancelled, now - submitTime);
+            });
+    }
+}
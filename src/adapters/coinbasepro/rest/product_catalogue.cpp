@@ -0,0 +1,176 @@
+#include "cryptoconnect/adapters/coinbasepro/rest/product_catalogue.hpp"
+
+#include "cryptoconnect/helpers/network/http/rate_limiter.hpp"
+#include "cryptoconnect/helpers/network/http/retry_policy.hpp"
+#include "cryptoconnect/structs/products.hpp"
+#include "cryptoconnect/adapters/coinbasepro/rest/connector.hpp"
+#include "cryptoconnect/adapters/coinbasepro/rest/decoders.hpp"
+
+#include <boost/asio/detached.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/asio/use_future.hpp>
+
+#include <unistd.h>
+
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+
+namespace CryptoConnect::CoinbasePro::REST
+{
+    void ProductCatalogue::start()
+    {
+        // Serve the persisted catalogue until the first refresh replaces it, unless it is too old to be trusted
+        std::error_code ec;
+        auto const modifiedTime = std::filesystem::last_write_time(this->snapshotPath_, ec);
+        bool const isFresh = !ec && std::filesystem::file_time_type::clock::now() - modifiedTime <
+                                        std::chrono::seconds(COINBASEPRO_PRODUCTS_SNAPSHOT_MAX_AGE_S);
+        if (!ec && !isFresh)
+            std::cerr << "Ignoring the persisted products at " << this->snapshotPath_
+                      << ": older than " << COINBASEPRO_PRODUCTS_SNAPSHOT_MAX_AGE_S << "s" << '\n';
+
+        std::string response;
+        if (isFresh)
+        {
+            std::ifstream file(this->snapshotPath_, std::ios::binary);
+            response.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+        if (!response.empty())
+        {
+            try
+            {
+                this->publish(std::move(response), false);
+            }
+            catch (std::exception const &e)
+            {
+                std::cerr << "Ignoring the persisted products at " << this->snapshotPath_ << ": " << e.what() << '\n';
+            }
+        }
+
+        net::co_spawn(
+            net::make_strand(this->restConnector_->ioc_),
+            this->refreshForever(),
+            net::detached);
+    }
+
+    Products::cataloguePtr_t ProductCatalogue::get()
+    {
+        if (auto catalogue = this->snapshot())
+            return catalogue;
+
+        // Blocking on the fetch from an io thread would wait on itself
+        if (this->restConnector_->ioc_.get_executor().running_in_this_thread())
+            throw std::logic_error("ProductCatalogue::get() blocks, await asyncGet() on the io threads");
+
+        // Nothing persisted and not refreshed yet, fetch once for every waiting caller (the refresh persists it)
+        std::lock_guard<std::mutex> lock(this->fetchMutex_);
+        if (auto catalogue = this->snapshot())
+            return catalogue;
+
+        return net::co_spawn(net::make_strand(this->restConnector_->ioc_), this->asyncGet(), net::use_future).get();
+    }
+
+    net::awaitable<Products::cataloguePtr_t> ProductCatalogue::asyncGet()
+    {
+        if (auto catalogue = this->snapshot())
+            co_return catalogue;
+
+        this->publish(co_await this->fetch(), false);
+        co_return this->snapshot();
+    }
+
+    /* Refreshes at every interval (failures keep the current catalogue until the next one) */
+    net::awaitable<void> ProductCatalogue::refreshForever()
+    {
+        net::steady_timer timer(co_await net::this_coro::executor);
+
+        for (;;)
+        {
+            try
+            {
+                this->publish(co_await this->fetch(), true);
+            }
+            catch (std::exception const &e)
+            {
+                std::cerr << "Failed to refresh the products: " << e.what() << '\n';
+            }
+
+            timer.expires_after(std::chrono::seconds(COINBASEPRO_PRODUCTS_REFRESH_S));
+            co_await timer.async_wait(net::use_awaitable);
+        }
+    }
+
+    net::awaitable<std::string> ProductCatalogue::fetch()
+    {
+        REST::Connector *restConnector = this->restConnector_;
+        co_return co_await Network::HTTP::asyncWithRetries(
+            restConnector->retryPolicy_, true,
+            [restConnector]
+            {
+                return restConnector->getPublicAsync(
+                    Network::HTTP::Priority::NORMAL, "GET /products", "/products");
+            });
+    }
+
+    void ProductCatalogue::publish(std::string response, bool isPersisted)
+    {
+        // Parsing clobbers the response, keep it aside to persist once it is known to be valid
+        std::string const persisted = isPersisted ? response : std::string();
+        size_t const hash = std::hash<std::string>{}(response);
+
+        {
+            std::lock_guard<std::mutex> lock(this->publishMutex_);
+
+            // Unchanged products keep the current catalogue (only a change retires one)
+            if (this->catalogues_.empty() || hash != this->publishedHash_)
+            {
+                auto catalogue = std::make_unique<Products::Catalogue>();
+                Decoders::parseProducts(std::span<char>(response.data(), response.size()), catalogue->products_);
+
+                // Kept alive until the catalogue is destroyed, readers may still hold the previous ones
+                this->catalogue_.store(catalogue.get(), std::memory_order_release);
+                this->catalogues_.push_back(std::move(catalogue));
+                this->publishedHash_ = hash;
+            }
+
+            // Lock guard goes out of scope and releases
+        }
+
+        // Persisted even if unchanged, its age is what the next start checks
+        if (!isPersisted)
+            return;
+
+        // Written aside then renamed over, so the next start never reads half a file
+        try
+        {
+            std::filesystem::path const path(this->snapshotPath_);
+            if (path.has_parent_path())
+                std::filesystem::create_directories(path.parent_path());
+
+            std::string const tempPath = this->snapshotPath_ + ".tmp" + std::to_string(::getpid());
+            {
+                std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+                file.write(persisted.data(), persisted.size());
+                if (!file.flush())
+                    throw std::runtime_error("Failed to write " + tempPath);
+            }
+            std::filesystem::rename(tempPath, path);
+        }
+        catch (std::exception const &e)
+        {
+            std::cerr << "Failed to persist the products: " << e.what() << '\n';
+        }
+    }
+}
@@ -1,70 +1,650 @@
 #include "cryptoconnect/adapters/coinbasepro/stream/connector.hpp"
 
 #include "cryptoconnect/helpers/network/websockets/client.hpp"
+#include "cryptoconnect/helpers/utils/datetime.hpp"
+#include "cryptoconnect/structs/events.hpp"
 #include "cryptoconnect/structs/universe.hpp"
 #include "cryptoconnect/adapters/coinbasepro/auth.hpp"
-#include "cryptoconnect/adapters/coinbasepro/stream/handler.hpp"
+#include "cryptoconnect/adapters/coinbasepro/stream/pipeline.hpp"
 
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/asio/use_future.hpp>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/json_parser.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <ctime>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <pthread.h>
 #include <thread>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace CryptoConnect::CoinbasePro::Stream
 {
     /* Constructor */
-    Connector::Connector(Auth *auth) : auth_(auth) {}
+    Connector::Connector(Auth *auth, Events::Queue *eventQueue, size_t numConnections)
+        : auth_(auth), eventQueue_(eventQueue),
+          pipeline_(eventQueue, numConnections ? numConnections : 1)
+    {
+        // Always keep at least one connection
+        if (!numConnections)
+            numConnections = 1;
+
+        for (size_t i = 0; i < numConnections; i++)
+            this->wsClients_.push_back(std::make_unique<Network::WebSockets::Client>(this->ioc_));
+
+        this->subscriptions_.resize(numConnections);
+        this->recoveries_.resize(numConnections);
+        this->pacings_.resize(numConnections);
+
+        // Get notified by the parsers as books get rebuilt
+        this->pipeline_.setSnapshotCallback(
+            [this](std::string const &productId)
+            { this->onSnapshot(productId); });
+
+        // Spread the products evenly by default
+        this->partitioner_ = [](std::string const &productId, size_t numConnections)
+        { return std::hash<std::string>{}(productId) % numConnections; };
+    }
+
+    /* Replaces the default hash partitioning */
+    void Connector::setPartitioner(partitioner_t partitioner)
+    {
+        std::lock_guard<std::mutex> lock(this->subscriptionsMutex_);
+        this->checkUnassigned();
+        this->partitioner_ = partitioner;
+        // Lock guard goes out of scope and releases
+    }
+
+    /* Pins each group of products onto its own connection */
+    void Connector::setProductGroups(std::vector<Universe::Universe> const &groups)
+    {
+        std::lock_guard<std::mutex> lock(this->subscriptionsMutex_);
+        this->checkUnassigned();
+
+        this->productGroups_.clear();
+        for (size_t i = 0; i < groups.size(); i++)
+        {
+            for (auto const &productId : groups[i])
+                this->productGroups_[productId] = i % this->wsClients_.size();
+        }
+        // Lock guard goes out of scope and releases
+    }
 
-    /* Connects to the socket */
+    /* Registers the callback for when every subscribed product has a valid book */
+    void Connector::setReadinessCallback(readinessCallback_t callback)
+    {
+        this->readinessCallback_ = callback;
+    }
+
+    /* Starts the io_context threads and connects the sockets */
     void Connector::connect()
     {
-        this->wsClient_.connect(COINBASEPRO_WS_ENDPOINT, "443");
+        // Only start the io_context threads once (e.g. when connecting again)
+        if (!this->isRunning_)
+        {
+            this->isRunning_ = true;
+            size_t const numThreads = COINBASEPRO_WS_IO_THREADS ? COINBASEPRO_WS_IO_THREADS : 1;
+            for (size_t i = 0; i < numThreads; i++)
+            {
+                std::thread ioThread(
+                    [this]
+                    {
+                        {
+                            std::lock_guard<std::mutex> lock(this->ioClocksMutex_);
+                            clockid_t clock;
+                            if (!pthread_getcpuclockid(pthread_self(), &clock))
+                                this->ioClocks_.push_back(clock);
+                            // Lock guard goes out of scope and releases
+                        }
+
+                        this->ioc_.run();
+                    });
+
+                ioThread.detach();
+            }
+        }
+
+        for (auto &wsClient : this->wsClients_)
+        {
+            wsClient->setCompression(
+                Network::WebSockets::Compression(COINBASEPRO_WS_COMPRESSION, COINBASEPRO_WS_WINDOW_BITS));
+
+            // Block until connected (rethrows the connection's failure)
+            net::co_spawn(
+                wsClient->getStrand(),
+                wsClient->connect(COINBASEPRO_WS_ENDPOINT, "443"),
+                net::use_future)
+                .get();
+
+            // Keepalive pinging on the client's own timer
+            wsClient->keepAlive(std::chrono::seconds(30));
+        }
+    }
+
+    /* Reads every connection in its own coroutine */
+    void Connector::streamForever()
+    {
+        this->pipeline_.start();
 
-        // Invoke keepalive pinging
-        std::thread keepAliveThread(
+        // Subscriptions are sent from their own thread as the snapshots come in
+        std::thread pacingThread(
             [this]
-            { this->keepAlive(); });
+            { this->paceSubscriptionsForever(); });
 
-        keepAliveThread.detach();
+        pacingThread.detach();
+
+        for (size_t i = 0; i < this->wsClients_.size(); i++)
+        {
+            // Readers only ever complete by failing
+            net::co_spawn(
+                this->wsClients_[i]->getStrand(),
+                this->readForever(i),
+                [this](std::exception_ptr failure)
+                {
+                    std::lock_guard<std::mutex> lock(this->failureMutex_);
+                    if (!this->failure_)
+                        this->failure_ = failure;
+                    this->hasFailed_.notify_one();
+                });
+        }
+
+        // Any reader failing brings the stream down, so rethrow the first failure on this thread
+        std::unique_lock<std::mutex> lock(this->failureMutex_);
+        this->hasFailed_.wait(
+            lock,
+            [this]
+            { return this->failure_ != nullptr; });
+
+        std::rethrow_exception(this->failure_);
     }
 
-    /* Loops and calls the callback on receiving a message */
-    void Connector::streamForever(Handler &handler)
+    /* Loops and hands the frames received on a connection over to the parsing pipeline */
+    net::awaitable<void> Connector::readForever(size_t connection)
     {
-        std::string message;
+        auto &wsClient = *this->wsClients_[connection];
+
+        // Frames are read in place into preallocated buffers, recycled through the rings' slots
+        Frame frame;
+
+        net::steady_timer retryTimer(co_await net::this_coro::executor);
 
         while (1)
         {
-            message.clear();
-            this->wsClient_.read(message);
-            handler.onMessage(message);
+            std::string failure;
+            try
+            {
+                frame.data_ = co_await wsClient.read(frame.buffer_);
+            }
+            catch (std::exception const &e)
+            {
+                failure = e.what();
+            }
+
+            // Cannot be awaited from within the handler
+            if (failure.size())
+            {
+                co_await this->recover(connection, failure);
+                continue;
+            }
+
+            // Back-pressure: stop reading the connection until its parser catches up, without holding the io thread
+            while (!this->pipeline_.tryDispatch(connection, frame))
+            {
+                retryTimer.expires_after(std::chrono::microseconds(STREAM_RING_RETRY_US));
+                co_await retryTimer.async_wait(net::use_awaitable);
+            }
+        }
+    }
+
+    /* Re-establishes a dropped connection and resubscribes its products */
+    net::awaitable<void> Connector::recover(size_t connection, std::string reason)
+    {
+        auto &wsClient = *this->wsClients_[connection];
+        uint64_t const disconnectTime = Utils::Datetime::epochNow<std::chrono::nanoseconds>();
+
+        std::cerr << "[WARNING] Stream connection " << connection << " dropped: " << reason << '\n';
+        this->eventQueue_->enqueue<Events::FeedStatus>(
+            disconnectTime, connection, Events::FeedStatus::Status::DISCONNECTED, 0, reason);
+
+        net::steady_timer backoffTimer(co_await net::this_coro::executor);
+        auto backoff = std::chrono::milliseconds(COINBASEPRO_WS_RECONNECT_MIN_BACKOFF_MS);
+        for (size_t attempt = 1;; attempt++)
+        {
+            try
+            {
+                co_await wsClient.reconnect();
+
+                // Requeue the connection's share of the universe to be resubscribed in paced batches
+                Universe::Universe shard;
+                {
+                    std::lock_guard<std::mutex> pacingLock(this->pacingMutex_);
+                    {
+                        std::lock_guard<std::mutex> lock(this->subscriptionsMutex_);
+                        shard.update(this->subscriptions_[connection]);
+                        // Lock guard goes out of scope and releases
+                    }
+
+                    // Its books are stale until the fresh snapshots arrive (track before they can arrive)
+                    {
+                        std::lock_guard<std::mutex> lock(this->recoveriesMutex_);
+                        Recovery &recovery = this->recoveries_[connection];
+                        recovery.isRecovering_ = shard.size() > 0;
+                        recovery.disconnectTime_ = disconnectTime;
+                        recovery.pendingProducts_ = std::unordered_set<std::string>(shard.begin(), shard.end());
+                        // Lock guard goes out of scope and releases
+                    }
+
+                    // Whatever was queued or in flight on the old stream is covered by the shard
+                    Pacing &pacing = this->pacings_[connection];
+                    pacing.queuedProducts_.clear();
+                    pacing.inFlightProducts_.clear();
+                    pacing.batchSize_ = COINBASEPRO_WS_SUBSCRIBE_MIN_BATCH;
+                    this->queueSubscriptions(connection, shard);
+
+                    this->pacingUpdated_.notify_one();
+                    // Lock guard goes out of scope and releases
+                }
+
+                uint64_t const downTime = Utils::Datetime::epochNow<std::chrono::nanoseconds>() - disconnectTime;
+                this->eventQueue_->enqueue<Events::FeedStatus>(
+                    disconnectTime + downTime, connection, Events::FeedStatus::Status::RECONNECTED,
+                    downTime, "Resubscribing " + std::to_string(shard.size()) + " products");
+
+                // Nothing to rebuild
+                if (!shard.size())
+                    this->eventQueue_->enqueue<Events::FeedStatus>(
+                        disconnectTime + downTime, connection, Events::FeedStatus::Status::RECOVERED,
+                        downTime, "No products to rebuild");
+
+                co_return;
+            }
+            catch (std::exception const &e)
+            {
+#if COINBASEPRO_WS_RECONNECT_ATTEMPTS > 0
+                if (attempt >= COINBASEPRO_WS_RECONNECT_ATTEMPTS)
+                    throw;
+#endif
+
+                std::cerr << "[WARNING] Stream connection " << connection << " reconnect attempt " << attempt
+                          << " failed: " << e.what() << " | Retrying in " << backoff.count() << "ms" << '\n';
+            }
+
+            // Back off without holding up the other connections on the io_context
+            backoffTimer.expires_after(backoff);
+            co_await backoffTimer.async_wait(net::use_awaitable);
+            backoff = std::min(backoff * 2, std::chrono::milliseconds(COINBASEPRO_WS_RECONNECT_MAX_BACKOFF_MS));
+        }
+    }
+
+    /* Called by the parsers whenever a product's book is rebuilt */
+    void Connector::onSnapshot(std::string const &productId)
+    {
+        size_t connection;
+        {
+            std::lock_guard<std::mutex> lock(this->subscriptionsMutex_);
+            auto const assignment = this->assignments_.find(productId);
+
+            // Guard clause for products unsubscribed since (nothing pending on them anymore)
+            if (assignment == this->assignments_.end())
+                return;
+
+            connection = assignment->second;
+            // Lock guard goes out of scope and releases
+        }
+
+        this->settleSubscription(connection, productId, true);
+        this->settleRecovery(connection, productId);
+    }
+
+    /* Marks a product's book as no longer pending, completing the recovery with the last one */
+    void Connector::settleRecovery(size_t connection, std::string const &productId)
+    {
+        uint64_t disconnectTime;
+
+        {
+            std::lock_guard<std::mutex> lock(this->recoveriesMutex_);
+            Recovery &recovery = this->recoveries_[connection];
+
+            // Guard clause for products outside of a recovery or not the last pending one
+            if (!recovery.isRecovering_ || !recovery.pendingProducts_.erase(productId) ||
+                recovery.pendingProducts_.size())
+                return;
+
+            recovery.isRecovering_ = false;
+            disconnectTime = recovery.disconnectTime_;
+            // Lock guard goes out of scope and releases (not held while enqueueing)
+        }
+
+        uint64_t const now = Utils::Datetime::epochNow<std::chrono::nanoseconds>();
+        std::cout << "[INFO] Stream connection " << connection << " recovered in "
+                  << (now - disconnectTime) / 1000000 << "ms" << '\n';
+
+        this->eventQueue_->enqueue<Events::FeedStatus>(
+            now, connection, Events::FeedStatus::Status::RECOVERED,
+            now - disconnectTime, "All books rebuilt");
+    }
+
+    /* Reads the websockets' wire and payload counters (summed across connections) */
+    void Connector::getStats(Network::WebSockets::Stats &output)
+    {
+        output = Network::WebSockets::Stats{};
+        for (auto &wsClient : this->wsClients_)
+        {
+            Network::WebSockets::Stats stats;
+            wsClient->getStats(stats);
+
+            output.frames_ += stats.frames_;
+            output.payloadBytes_ += stats.payloadBytes_;
+            output.wireBytes_ += stats.wireBytes_;
+            output.readCpuNanoseconds_ += stats.readCpuNanoseconds_;
+            output.isCompressed_ = stats.isCompressed_;
+        }
+
+        // The reads are all driven by the io_context threads
+        std::lock_guard<std::mutex> lock(this->ioClocksMutex_);
+        for (auto const clock : this->ioClocks_)
+        {
+            timespec cpuTime;
+            if (!clock_gettime(clock, &cpuTime))
+                output.ioCpuNanoseconds_ += cpuTime.tv_sec * 1000000000ULL + cpuTime.tv_nsec;
         }
     }
 
-    /* Subscribes to products */
+    /* Subscribes to products (paced in batches by each connection) */
     void Connector::subscribeProducts(Universe::Universe const &universe)
     {
-        // Guard clause for when called with empty universe
-        if (!universe.size())
-            return;
+        std::lock_guard<std::mutex> lock(this->pacingMutex_);
+
+        // Track the subscriptions first for them to be replayed if the connection is down
+        std::vector<Universe::Universe> shards(this->wsClients_.size());
+        {
+            std::lock_guard<std::mutex> subscriptionsLock(this->subscriptionsMutex_);
+            for (auto const &productId : universe)
+            {
+                // Products already subscribed keep their books (and their connection)
+                if (this->assignments_.count(productId))
+                    continue;
+
+                size_t const connection = this->partition(productId);
+                this->assignments_[productId] = connection;
+                this->subscriptions_[connection].emplace(productId);
+                shards[connection].emplace(productId);
+            }
+            // Lock guard goes out of scope and releases
+        }
+
+        for (size_t i = 0; i < shards.size(); i++)
+        {
+            Universe::Universe const &newUniverse = shards[i];
+
+            // Guard clause for connections without any new products
+            if (!newUniverse.size())
+                continue;
 
-        std::string message;
-        this->makeSubscriptionMessage("subscribe", universe, message);
-        this->wsClient_.write(message);
+            // Readiness is timed from the first product missing a book
+            if (this->unreadyProducts_.empty())
+            {
+                this->readinessStartTime_ = Utils::Datetime::epochNow<std::chrono::nanoseconds>();
+                this->timedOutProducts_ = 0;
+            }
+            for (auto const &productId : newUniverse)
+                this->unreadyProducts_.emplace(productId);
+
+            this->queueSubscriptions(i, newUniverse);
+        }
+
+        this->pacingUpdated_.notify_one();
+        // Lock guard goes out of scope and releases
     }
 
-    /* Unsubscribes to products */
+    /* Unsubscribes to products (immediately) */
     void Connector::unsubscribeProducts(Universe::Universe const &universe)
     {
-        // Guard clause for when called with empty universe
-        if (!universe.size())
-            return;
+        // Untrack the subscriptions first for them not to be replayed on reconnection
+        std::vector<Universe::Universe> shards(this->wsClients_.size());
+        {
+            std::lock_guard<std::mutex> lock(this->subscriptionsMutex_);
+            for (auto const &productId : universe)
+            {
+                // Guard clause for products not subscribed
+                auto const assignment = this->assignments_.find(productId);
+                if (assignment == this->assignments_.end())
+                    continue;
+
+                // Sent on the connection the product was subscribed on
+                size_t const connection = assignment->second;
+                this->assignments_.erase(assignment);
+                this->subscriptions_[connection].erase(productId);
+                shards[connection].emplace(productId);
+            }
+            // Lock guard goes out of scope and releases
+        }
+
+        for (size_t i = 0; i < shards.size(); i++)
+        {
+            // Guard clause for connections without any of the products
+            if (!shards[i].size())
+                continue;
+
+            // Unsubscribed products no longer hold up a batch, the readiness or a recovery
+            for (auto const &productId : shards[i])
+            {
+                this->settleSubscription(i, productId, false);
+                this->settleRecovery(i, productId);
+            }
+
+            // Queued on the connection's strand (dropped while it is down, nothing to replay then)
+            std::string message;
+            this->makeSubscriptionMessage("unsubscribe", shards[i], message);
+            this->wsClients_[i]->write(std::move(message));
+        }
+    }
+
+    /* Picks the connection for a product being subscribed */
+    size_t Connector::partition(std::string const &productId) const
+    {
+        auto const group = this->productGroups_.find(productId);
+        if (group != this->productGroups_.end())
+            return group->second;
+
+        return this->partitioner_(productId, this->wsClients_.size()) % this->wsClients_.size();
+    }
+
+    /* Throws if any product has been assigned a connection */
+    void Connector::checkUnassigned() const
+    {
+        if (this->assignments_.size())
+            throw std::runtime_error("Stream partitioning cannot change once products are subscribed");
+    }
+
+    /* Queues products for a connection to subscribe in its next batches */
+    void Connector::queueSubscriptions(size_t connection, Universe::Universe const &universe)
+    {
+        Pacing &pacing = this->pacings_[connection];
+        for (auto const &productId : universe)
+        {
+            // Guard clause for products already on their way
+            if (pacing.inFlightProducts_.count(productId) ||
+                std::find(pacing.queuedProducts_.begin(), pacing.queuedProducts_.end(), productId) !=
+                    pacing.queuedProducts_.end())
+                continue;
+
+            pacing.queuedProducts_.push_back(productId);
+        }
+    }
+
+    /* Sends every connection its next batch of subscriptions as soon as its last one is done */
+    void Connector::paceSubscriptionsForever()
+    {
+        auto const timeout = std::chrono::milliseconds(COINBASEPRO_WS_SUBSCRIBE_TIMEOUT_MS);
+
+        std::unique_lock<std::mutex> lock(this->pacingMutex_);
+        while (1)
+        {
+            uint64_t const now = Utils::Datetime::epochNow<std::chrono::nanoseconds>();
+            bool isReady = false;
+            size_t readyConnection = 0;
+
+            // Sleep until the earliest batch times out (or until woken up by a snapshot or subscription)
+            auto wait = std::chrono::nanoseconds::max();
+            for (size_t i = 0; i < this->pacings_.size(); i++)
+            {
+                Pacing &pacing = this->pacings_[i];
+
+                if (pacing.inFlightProducts_.size())
+                {
+                    auto const elapsed = std::chrono::nanoseconds(now - pacing.batchTime_);
+
+                    // Guard clause for a batch still waiting on its snapshots
+                    if (elapsed < timeout)
+                    {
+                        wait = std::min<std::chrono::nanoseconds>(wait, timeout - elapsed);
+                        continue;
+                    }
+
+                    std::cerr << "[WARNING] Stream connection " << i << " still missing "
+                              << pacing.inFlightProducts_.size() << " snapshots after " << timeout.count()
+                              << "ms | Sending the next batch" << '\n';
+
+                    // Given up on (e.g. delisted or dropped), they no longer hold readiness back
+                    bool wasUnready = false;
+                    for (auto const &productId : pacing.inFlightProducts_)
+                        if (this->unreadyProducts_.erase(productId))
+                        {
+                            this->timedOutProducts_++;
+                            wasUnready = true;
+                        }
+                    if (wasUnready && this->unreadyProducts_.empty())
+                    {
+                        isReady = true;
+                        readyConnection = i;
+                    }
+
+                    pacing.inFlightProducts_.clear();
+                    pacing.batchSize_ = COINBASEPRO_WS_SUBSCRIBE_MIN_BATCH;
+                }
+
+                // Guard clause for connections with nothing left to subscribe
+                if (pacing.queuedProducts_.empty())
+                    continue;
+
+                Universe::Universe batch;
+                while (batch.size() < pacing.batchSize_ && pacing.queuedProducts_.size())
+                {
+                    batch.emplace(pacing.queuedProducts_.front());
+                    pacing.inFlightProducts_.emplace(pacing.queuedProducts_.front());
+                    pacing.queuedProducts_.pop_front();
+                }
+
+                pacing.batchCount_ = batch.size();
+                pacing.batchTime_ = now;
+                wait = std::min<std::chrono::nanoseconds>(wait, timeout);
+
+                // Queued on the connection's strand (dropped while it is down, requeued on reconnection)
+                std::string message;
+                this->makeSubscriptionMessage("subscribe", batch, message);
+                this->wsClients_[i]->write(std::move(message));
+            }
+
+            // Reported without holding the lock (the callback may subscribe)
+            if (isReady)
+            {
+                uint64_t const startTime = this->readinessStartTime_;
+                size_t const numTimedOut = this->timedOutProducts_;
+                lock.unlock();
+                this->reportReadiness(readyConnection, startTime, now, numTimedOut);
+                lock.lock();
+                continue;
+            }
+
+            if (wait == std::chrono::nanoseconds::max())
+                this->pacingUpdated_.wait(lock);
+            else
+                this->pacingUpdated_.wait_for(lock, wait);
+        }
+    }
+
+    /* Marks a product as no longer pending, reporting readiness with the last one */
+    void Connector::settleSubscription(size_t connection, std::string const &productId, bool const isSnapshot)
+    {
+        uint64_t const now = Utils::Datetime::epochNow<std::chrono::nanoseconds>();
+        uint64_t startTime;
+        size_t numTimedOut;
+
+        {
+            std::lock_guard<std::mutex> lock(this->pacingMutex_);
+            Pacing &pacing = this->pacings_[connection];
+
+            if (!isSnapshot)
+            {
+                auto const queued = std::find(pacing.queuedProducts_.begin(), pacing.queuedProducts_.end(), productId);
+                if (queued != pacing.queuedProducts_.end())
+                    pacing.queuedProducts_.erase(queued);
+            }
+
+            // Last snapshot of the batch: size the next one to the throughput it was delivered at
+            if (pacing.inFlightProducts_.erase(productId) && pacing.inFlightProducts_.empty())
+            {
+                if (isSnapshot)
+                {
+                    uint64_t const elapsed = std::max<uint64_t>(now - pacing.batchTime_, 1);
+                    uint64_t const batchSize = pacing.batchCount_ * COINBASEPRO_WS_SUBSCRIBE_BATCH_MS * 1000000ULL / elapsed;
+                    pacing.batchSize_ = std::clamp<uint64_t>(
+                        batchSize, COINBASEPRO_WS_SUBSCRIBE_MIN_BATCH, COINBASEPRO_WS_SUBSCRIBE_MAX_BATCH);
+                }
+
+                this->pacingUpdated_.notify_one();
+            }
+
+            // Guard clause for products that were not pending or not the last pending one
+            if (!this->unreadyProducts_.erase(productId) || this->unreadyProducts_.size())
+                return;
+
+            // Taken under the lock, a concurrent subscription restarts the readiness
+            startTime = this->readinessStartTime_;
+            numTimedOut = this->timedOutProducts_;
+            // Lock guard goes out of scope and releases (not held while enqueueing)
+        }
+
+        this->reportReadiness(connection, startTime, now, numTimedOut);
+    }
+
+    /* Reports that no product is pending anymore */
+    void Connector::reportReadiness(size_t connection, uint64_t startTime, uint64_t readyTime, size_t numTimedOut)
+    {
+        uint64_t const readinessTime = readyTime - startTime;
+
+        if (numTimedOut)
+        {
+            std::cerr << "[WARNING] Stream partially ready in " << readinessTime / 1000000 << "ms | "
+                      << numTimedOut << " products timed out without a book" << '\n';
+            this->eventQueue_->enqueue<Events::FeedStatus>(
+                readyTime, connection, Events::FeedStatus::Status::PARTIAL, readinessTime,
+                std::to_string(numTimedOut) + " products timed out without a book");
+        }
+        else
+        {
+            std::cout << "[INFO] Stream ready in " << readinessTime / 1000000 << "ms" << '\n';
+            this->eventQueue_->enqueue<Events::FeedStatus>(
+                readyTime, connection, Events::FeedStatus::Status::READY, readinessTime,
+                "Every subscribed product has a book");
+        }
 
-        std::string message;
-        this->makeSubscriptionMessage("unsubscribe", universe, message);
-        this->wsClient_.write(message);
+        if (this->readinessCallback_)
+            this->readinessCallback_(readinessTime, numTimedOut);
     }
 
     /* Constructs the subscription message from the type and the unvierse */
@@ -126,13 +706,4 @@ namespace CryptoConnect::CoinbasePro::Stream
 
         output = ss.str();
     }
-
-    void Connector::keepAlive()
-    {
-        while (1)
-        {
-            std::this_thread::sleep_for(std::chrono::seconds(30));
-            this->wsClient_.ping("keepalive");
-        }
-    }
 }
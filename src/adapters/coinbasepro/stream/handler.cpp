@@ -8,21 +8,58 @@
 #include <rapidjson/writer.h>
 
 #include <iostream>
+#include <span>
 #include <unordered_map>
 #include <unordered_set>
 #include <string>
+#include <string_view>
 
 namespace CryptoConnect::CoinbasePro::Stream
 {
-    void Handler::onMessage(std::string const &message)
+    namespace
     {
-        rapidjson::Document document;
-        document.Parse(message.c_str());
+        /* Serializes a parsed document back for logging (the in-situ source is clobbered) */
+        std::string stringify(document_t const &document)
+        {
+            rapidjson::StringBuffer buffer;
+            rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+            document.Accept(writer);
+            return buffer.GetString();
+        }
+    }
+
+    /* Constructor */
+    Handler::Handler(Events::Queue *eventQueue)
+        : eventQueue_(eventQueue),
+          valueBuffer_(STREAM_PARSE_BUFFER_SIZE), stackBuffer_(STREAM_PARSE_BUFFER_SIZE),
+          valueAllocator_(this->valueBuffer_.data(), this->valueBuffer_.size()),
+          stackAllocator_(this->stackBuffer_.data(), this->stackBuffer_.size()){};
+
+    void Handler::setSnapshotCallback(snapshotCallback_t callback)
+    {
+        this->snapshotCallback_ = callback;
+    }
 
-        auto type = std::string(document["type"].GetString());
+    void Handler::onMessage(std::span<char> message)
+    {
+        // Release whatever the previous message used (keeps the preallocated buffers)
+        this->valueAllocator_.Clear();
+        this->stackAllocator_.Clear();
+
+        document_t document(&this->valueAllocator_, 1024, &this->stackAllocator_);
+        document.ParseInsitu(message.data());
+
+        if (document.HasParseError() || !document.IsObject() || !document.HasMember("type"))
+        {
+            std::cerr << "Unparsable message received" << '\n';
+            return;
+        }
+
+        auto const &typeValue = document["type"];
+        auto type = std::string_view(typeValue.GetString(), typeValue.GetStringLength());
 
         if (type == "subscriptions")
-            std::cout << "subscription event: " << message << '\n';
+            std::cout << "subscription event: " << stringify(document) << '\n';
         else if (type == "snapshot")
             this->handleSnapshot(document);
         else if (type == "l2update") // Tick
@@ -38,9 +75,9 @@ namespace CryptoConnect::CoinbasePro::Stream
         else if (type == "match")
             this->handleOrderMatch(document); // Transaction
         else if (type == "error")
-            std::cerr << "Error encountered: " << message << '\n';
+            std::cerr << "Error encountered: " << stringify(document) << '\n';
         else
-            std::cout << "Unrecognized event: " << message << '\n';
+            std::cout << "Unrecognized event: " << stringify(document) << '\n';
     }
 
     void Handler::handleSnapshot(document_t &document)
@@ -70,6 +107,10 @@ namespace CryptoConnect::CoinbasePro::Stream
             // Update the best tick detail for the given product
             this->tickTracker_[productId] = Events::Tick(
                 0, productId, bestBidPrice, bestAskPrice, bestBidVolume, bestAskVolume, true);
+
+            // Notify that the product's book is valid
+            if (this->snapshotCallback_)
+                this->snapshotCallback_(productId);
         }
         catch (std::exception const &e)
         {
@@ -0,0 +1,128 @@
+#include "cryptoconnect/adapters/coinbasepro/stream/pipeline.hpp"
+
+#include "cryptoconnect/structs/event_queue.hpp"
+#include "cryptoconnect/adapters/coinbasepro/stream/handler.hpp"
+
+#include <functional>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+namespace CryptoConnect::CoinbasePro::Stream
+{
+    /* Constructor */
+    Pipeline::Pipeline(Events::Queue *eventQueue, size_t numReaders, size_t numWorkers)
+    {
+        // Always keep at least one reader and parser
+        if (!numReaders)
+            numReaders = 1;
+        if (!numWorkers)
+            numWorkers = 1;
+
+        for (size_t i = 0; i < numWorkers; i++)
+            this->workers_.push_back(std::make_unique<Worker>(eventQueue, numReaders));
+    }
+
+    /* Registers the callback for rebuilt books on every parser */
+    void Pipeline::setSnapshotCallback(snapshotCallback_t callback)
+    {
+        for (auto &worker : this->workers_)
+            worker->handler_.setSnapshotCallback(callback);
+    }
+
+    /* Spawns the parser threads */
+    void Pipeline::start()
+    {
+        for (auto &worker : this->workers_)
+        {
+            std::thread parserThread(
+                [this, &worker]
+                { this->parseForever(*worker); });
+
+            parserThread.detach();
+        }
+    }
+
+    /* Hands a reader's raw frame over to its parser unless its ring is full */
+    bool Pipeline::tryDispatch(size_t reader, Frame &frame)
+    {
+        Worker &worker = *this->workers_[this->route(frame.data_)];
+        ring_t &ring = *worker.rings_[reader];
+
+        // Guard clause for a parser too far behind (back-pressure is left to the reader)
+        Frame *slot = ring.acquire();
+        if (!slot)
+            return false;
+
+        // Swap the frame in without copying, the reader reads the next one into the buffer the parser is done with
+        std::swap(*slot, frame);
+        ring.publish();
+
+        // Wake the parser up if it is sleeping
+        worker.signal_.fetch_add(1, std::memory_order_release);
+        worker.signal_.notify_one();
+        return true;
+    }
+
+    /* Picks the worker responsible for the frame's product */
+    size_t Pipeline::route(std::span<char const> frame) const
+    {
+        // Guard clause for a single parser
+        if (this->workers_.size() == 1)
+            return 0;
+
+        // Peek at the product ID without parsing the frame (CoinbasePro sends compact JSON)
+        static constexpr std::string_view key = "\"product_id\":\"";
+        std::string_view view(frame.data(), frame.size());
+
+        size_t start = view.find(key);
+        if (start == std::string_view::npos)
+            return 0; // Product-less messages (e.g. subscriptions, errors) go to the first parser
+
+        start += key.size();
+        size_t end = view.find('"', start);
+        if (end == std::string_view::npos)
+            return 0;
+
+        std::string_view productId = view.substr(start, end - start);
+        return std::hash<std::string_view>{}(productId) % this->workers_.size();
+    }
+
+    /* Loops and parses the frames routed to the worker */
+    void Pipeline::parseForever(Worker &worker)
+    {
+        while (1)
+        {
+            uint64_t signal = worker.signal_.load(std::memory_order_acquire);
+
+            // Drain everything that has been published so far, in batches so no reader starves the others
+            size_t numParsed;
+            do
+            {
+                numParsed = 0;
+                for (auto &ring : worker.rings_)
+                {
+                    Frame *frame;
+                    for (size_t i = 0; i < STREAM_PARSE_BATCH && (frame = ring->front()); i++)
+                    {
+                        try
+                        {
+                            worker.handler_.onMessage(frame->data_);
+                        }
+                        catch (std::exception const &e)
+                        {
+                            std::cerr << "Failed to handle message: " << e.what() << '\n';
+                        }
+                        ring->pop();
+                        numParsed++;
+                    }
+                }
+            } while (numParsed);
+
+            // Sleep until a reader publishes again
+            worker.signal_.wait(signal, std::memory_order_acquire);
+        }
+    }
+}
@@ -0,0 +1,176 @@
+#include "cryptoconnect/helpers/network/dns/cache.hpp"
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Network::DNS
+{
+    /* Cache shared by the process */
+    Cache &Cache::shared()
+    {
+        // Never destroyed: its refreshing thread runs until the process exits
+        static Cache *cache = []
+        {
+            Cache *cache = new Cache();
+
+            std::thread refreshingThread(
+                [cache]
+                { cache->refreshForever(); });
+
+            refreshingThread.detach();
+            return cache;
+        }();
+
+        return *cache;
+    }
+
+    /* Addresses of the host */
+    endpoints_t Cache::resolve(std::string const &host, std::string const &port)
+    {
+        endpoints_t endpoints;
+        if (this->find(host, port, endpoints))
+            return endpoints;
+
+        endpoints = Cache::lookup(host, port);
+        this->store(host, port, endpoints);
+        return endpoints;
+    }
+
+    /* Addresses of the host (awaiting the resolver on a miss) */
+    boost::asio::awaitable<endpoints_t> Cache::asyncResolve(std::string const &host, std::string const &port)
+    {
+        endpoints_t endpoints;
+        if (this->find(host, port, endpoints))
+            co_return endpoints;
+
+        // Asio runs the lookup on its own resolver thread, the calling io thread keeps serving its other work
+        tcp::resolver resolver(co_await boost::asio::this_coro::executor);
+        for (auto const &result : co_await resolver.async_resolve(host, port, boost::asio::use_awaitable))
+            endpoints.push_back(result.endpoint());
+
+        if (endpoints.empty())
+            throw std::runtime_error("No addresses found for " + host);
+
+        this->store(host, port, endpoints);
+        co_return endpoints;
+    }
+
+    /* Addresses of the host if already resolved */
+    bool Cache::find(std::string const &host, std::string const &port, endpoints_t &output)
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+
+        auto const entry = this->entries_.find(host + ':' + port);
+        if (entry == this->entries_.end())
+            return false;
+
+        output = entry->second.endpoints_;
+        return true;
+        // Lock guard goes out of scope and releases
+    }
+
+    /* Caches freshly resolved addresses */
+    void Cache::store(std::string const &host, std::string const &port, endpoints_t const &endpoints)
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        this->entries_[host + ':' + port] = Entry{host, port, endpoints, std::chrono::steady_clock::now()};
+        // Lock guard goes out of scope and releases
+    }
+
+    /* Moves the address a connection succeeded on to the front */
+    void Cache::promote(std::string const &host, std::string const &port, tcp::endpoint const &endpoint)
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+
+        auto const entry = this->entries_.find(host + ':' + port);
+        if (entry == this->entries_.end())
+            return;
+
+        endpoints_t &endpoints = entry->second.endpoints_;
+        auto const position = std::find(endpoints.begin(), endpoints.end(), endpoint);
+        if (position != endpoints.end())
+            std::rotate(endpoints.begin(), position, position + 1);
+        // Lock guard goes out of scope and releases
+    }
+
+    /* Resolves the host synchronously */
+    endpoints_t Cache::lookup(std::string const &host, std::string const &port)
+    {
+        boost::asio::io_context ioc;
+        tcp::resolver resolver(ioc);
+
+        endpoints_t endpoints;
+        for (auto const &result : resolver.resolve(host, port))
+            endpoints.push_back(result.endpoint());
+
+        if (endpoints.empty())
+            throw std::runtime_error("No addresses found for " + host);
+
+        return endpoints;
+    }
+
+    /* Loops and refreshes the entries past their TTL */
+    void Cache::refreshForever()
+    {
+        auto const ttl = std::chrono::seconds(DNS_CACHE_TTL_S);
+
+        while (1)
+        {
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+
+            // Pick the expired entries
+            std::vector<std::pair<std::string, std::string>> expiredHosts;
+            {
+                std::lock_guard<std::mutex> lock(this->mutex_);
+                auto const now = std::chrono::steady_clock::now();
+                for (auto const &pair : this->entries_)
+                {
+                    if (now - pair.second.resolveTime_ >= ttl)
+                        expiredHosts.emplace_back(pair.second.host_, pair.second.port_);
+                }
+                // Lock guard goes out of scope and releases (not held while resolving)
+            }
+
+            for (auto const &[host, port] : expiredHosts)
+            {
+                endpoints_t endpoints;
+                try
+                {
+                    endpoints = Cache::lookup(host, port);
+                }
+                catch (std::exception const &e)
+                {
+                    std::cerr << "[WARNING] Failed to refresh the addresses of " << host << ": " << e.what()
+                              << " | Keeping the previous ones" << '\n';
+                }
+
+                std::lock_guard<std::mutex> lock(this->mutex_);
+                Entry &entry = this->entries_[host + ':' + port];
+                entry.resolveTime_ = std::chrono::steady_clock::now();
+
+                // Keep the address currently in use first if it is still served
+                if (endpoints.size())
+                {
+                    auto const current = std::find(endpoints.begin(), endpoints.end(), entry.endpoints_.front());
+                    if (current != endpoints.end())
+                        std::rotate(endpoints.begin(), current, current + 1);
+                    entry.endpoints_ = std::move(endpoints);
+                }
+                // Lock guard goes out of scope and releases
+            }
+        }
+    }
+}
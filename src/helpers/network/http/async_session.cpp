@@ -0,0 +1,369 @@
+#include "cryptoconnect/helpers/network/http/async_session.hpp"
+
+#include "cryptoconnect/helpers/network/dns/cache.hpp"
+#include "cryptoconnect/helpers/network/http/rate_limiter.hpp"
+#include "cryptoconnect/helpers/network/tls/context.hpp"
+#include "cryptoconnect/helpers/network/tls/liveness.hpp"
+
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+#include <boost/beast/ssl.hpp>
+#include <boost/beast/version.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace Network::HTTP
+{
+    /* Constructor */
+    AsyncSession::AsyncSession(net::io_context &ioc, char const *host, char const *port, size_t maxConnections)
+        : ioc_(ioc), tls_(TLS::Context::shared(host)), host_(host), port_(port),
+          maxConnections_(maxConnections ? maxConnections : 1) {}
+
+    void AsyncSession::addHeaders(headers_t const headers)
+    {
+        this->headers_.insert(headers.begin(), headers.end());
+    }
+
+    void AsyncSession::addRequestDecorator(requestDecorator_t decorator)
+    {
+        this->requestDecorators_.push_back(decorator);
+    }
+
+    /* Opens connections upfront and keeps them warm */
+    void AsyncSession::keepWarm(size_t numConnections, std::chrono::seconds interval, std::string pingTarget,
+                                RateLimiter *limiter)
+    {
+        net::co_spawn(
+            net::make_strand(this->ioc_),
+            this->maintainWarm(numConnections, interval, std::move(pingTarget), limiter),
+            net::detached);
+    }
+
+    /* Reopens the missing connections and pings the stale ones at every interval */
+    net::awaitable<void> AsyncSession::maintainWarm(size_t numConnections, std::chrono::seconds interval,
+                                                    std::string pingTarget, RateLimiter *limiter)
+    {
+        net::steady_timer timer(co_await net::this_coro::executor);
+        std::string const endpoint = "GET " + pingTarget;
+
+        for (;;)
+        {
+            // Reopen the missing connections in the free slots (a handshake, no request to meter)
+            size_t numMissing = 0;
+            {
+                std::lock_guard<std::mutex> lock(this->mutex_);
+                for (; this->numConnections_ < std::min(numConnections, this->maxConnections_); numMissing++)
+                    this->numConnections_++;
+
+                // Lock guard goes out of scope and releases
+            }
+            for (size_t i = 0; i < numMissing; i++)
+                net::co_spawn(net::make_strand(this->ioc_), this->openIdle(), net::detached);
+
+            // One ping at a time on the connections idle for the whole interval (never waiting for a slot, a request is held up by a single ping at most)
+            auto const staleBefore = std::chrono::steady_clock::now() - interval;
+            for (;;)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(this->mutex_);
+                    if (this->idleConnections_.empty() || this->idleConnections_.front()->lastUsed_ >= staleBefore)
+                        break;
+
+                    // Lock guard goes out of scope and releases
+                }
+
+                // Metered behind every other request (the connection is only taken once the token is)
+                if (limiter)
+                    co_await limiter->asyncAcquire(Priority::LOW, endpoint);
+
+                std::unique_ptr<Connection> connection = this->takeStale(staleBefore);
+                if (!connection)
+                    break;
+
+                // A failed ping leaves the connection unreusable, its slot is freed for the next round to reopen
+                request_t req{http::verb::get, pingTarget, 11};
+                try
+                {
+                    co_await this->send(*connection, req);
+                }
+                catch (...)
+                {
+                }
+                this->release(std::move(connection));
+            }
+
+            timer.expires_after(interval);
+            co_await timer.async_wait(net::use_awaitable);
+        }
+    }
+
+    /* Takes the least recently used idle connection if stale */
+    std::unique_ptr<AsyncSession::Connection> AsyncSession::takeStale(std::chrono::steady_clock::time_point staleBefore)
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+
+        if (this->idleConnections_.empty() || this->idleConnections_.front()->lastUsed_ >= staleBefore)
+            return nullptr;
+
+        std::unique_ptr<Connection> connection = std::move(this->idleConnections_.front());
+        this->idleConnections_.erase(this->idleConnections_.begin());
+        return connection;
+    }
+
+    /* Opens a connection and keeps it idle */
+    net::awaitable<void> AsyncSession::openIdle()
+    {
+        std::unique_ptr<Connection> connection;
+        try
+        {
+            connection = co_await this->connect();
+            connection->isReusable_ = true;
+        }
+        catch (...)
+        {
+        }
+
+        this->release(std::move(connection));
+    }
+
+    /* Coroutine request */
+    net::awaitable<std::string> AsyncSession::request(http::verb method, std::string target, std::string body)
+    {
+        // Hop onto a strand of our own whatever the caller's executor is
+        co_return co_await net::co_spawn(
+            net::make_strand(this->ioc_),
+            this->perform(method, std::move(target), std::move(body)),
+            net::use_awaitable);
+    }
+
+    /* Coroutine request returning the whole response */
+    net::awaitable<response_t> AsyncSession::exchange(http::verb method, std::string target, std::string body)
+    {
+        // Hop onto a strand of our own whatever the caller's executor is
+        co_return co_await net::co_spawn(
+            net::make_strand(this->ioc_),
+            this->transact(method, std::move(target), std::move(body)),
+            net::use_awaitable);
+    }
+
+    /* Performs the request */
+    net::awaitable<std::string> AsyncSession::perform(http::verb method, std::string target, std::string body)
+    {
+        response_t response = co_await this->transact(method, std::move(target), std::move(body));
+        co_return std::move(response.body());
+    }
+
+    /* Performs the request for its whole response */
+    net::awaitable<response_t> AsyncSession::transact(http::verb method, std::string target, std::string body)
+    {
+        request_t req{method, target, 11};
+        req.body() = std::move(body);
+
+        for (int attempt = 0;; attempt++)
+        {
+            bool isReused = false;
+            std::unique_ptr<Connection> connection = co_await this->acquire(isReused);
+
+            response_t output;
+            std::exception_ptr failure;
+            bool isStatusError = false;
+            try
+            {
+                if (!connection)
+                    connection = co_await this->connect();
+
+                output = co_await this->send(*connection, req);
+            }
+            catch (StatusError const &e)
+            {
+                failure = std::current_exception();
+                isStatusError = true;
+            }
+            catch (...)
+            {
+                failure = std::current_exception();
+            }
+
+            // Failed connections are closed and free their slot up (kept if the host answered with an error status)
+            this->release(std::move(connection));
+            if (!failure)
+                co_return output;
+
+            // Only a reused connection can have been closed by the host in between (non-idempotent requests are never replayed)
+            if (isStatusError || !isReused || attempt || method == http::verb::post)
+                std::rethrow_exception(failure);
+        }
+    }
+
+    /* Takes an idle connection, or waits for one if they are all busy */
+    net::awaitable<std::unique_ptr<AsyncSession::Connection>> AsyncSession::acquire(bool &isReused)
+    {
+        auto executor = co_await net::this_coro::executor;
+        std::shared_ptr<Waiter> waiter;
+        bool isClosed = false;
+
+        while (!waiter)
+        {
+            std::unique_ptr<Connection> connection;
+
+            {
+                std::lock_guard<std::mutex> lock(this->mutex_);
+
+                // The last one tried was closed by the host in the meantime, its slot is free
+                if (isClosed)
+                    this->numConnections_--;
+
+                // Most recently used first
+                if (!this->idleConnections_.empty())
+                {
+                    connection = std::move(this->idleConnections_.back());
+                    this->idleConnections_.pop_back();
+                }
+                // Open a new connection if there is room for one
+                else if (this->numConnections_ < this->maxConnections_)
+                {
+                    this->numConnections_++;
+                    co_return nullptr;
+                }
+                // Otherwise queue up for the next connection released
+                else
+                {
+                    waiter = std::make_shared<Waiter>(executor);
+                    waiter->timer_.expires_at(net::steady_timer::time_point::max());
+                    this->waiters_.push_back(waiter);
+                }
+
+                // Lock guard goes out of scope and releases
+            }
+
+            // Probed off the lock (a syscall), the connection is ours until released
+            if (connection)
+            {
+                isClosed = !TLS::isIdleOpen(connection->stream_);
+                if (!isClosed)
+                {
+                    isReused = true;
+                    co_return connection;
+                }
+            }
+        }
+
+        // Woken up by the releaser cancelling the timer (on our strand, so never before the wait starts)
+        boost::system::error_code ec;
+        while (!waiter->isReady_.load(std::memory_order_acquire))
+            co_await waiter->timer_.async_wait(net::redirect_error(net::use_awaitable, ec));
+
+        isReused = (bool)waiter->connection_;
+        co_return std::move(waiter->connection_);
+    }
+
+    /* Hands the connection over to a waiting request or keeps it idle */
+    void AsyncSession::release(std::unique_ptr<Connection> connection)
+    {
+        if (connection && !connection->isReusable_)
+            connection.reset();
+
+        std::shared_ptr<Waiter> waiter;
+        {
+            std::lock_guard<std::mutex> lock(this->mutex_);
+
+            if (this->waiters_.empty())
+            {
+                if (connection)
+                {
+                    connection->lastUsed_ = std::chrono::steady_clock::now();
+                    this->idleConnections_.push_back(std::move(connection));
+                }
+                else
+                    this->numConnections_--;
+                return;
+            }
+
+            // An empty handover passes the slot on for the waiter to open a connection in
+            waiter = std::move(this->waiters_.front());
+            this->waiters_.pop_front();
+            waiter->connection_ = std::move(connection);
+            waiter->isReady_.store(true, std::memory_order_release);
+
+            // Lock guard goes out of scope and releases
+        }
+
+        net::post(waiter->timer_.get_executor(), [waiter]
+                  { waiter->timer_.cancel(); });
+    }
+
+    /* Opens a new connection */
+    net::awaitable<std::unique_ptr<AsyncSession::Connection>> AsyncSession::connect()
+    {
+        auto connection = std::make_unique<Connection>(this->ioc_, this->tls_.getContext());
+        auto &stream = connection->stream_;
+
+        // Resolve the host and port for the IPs (cached, a first lookup is awaited without blocking the io thread)
+        DNS::Cache &dnsCache = DNS::Cache::shared();
+        auto const endpoints = co_await dnsCache.asyncResolve(this->host_, this->port_);
+
+        // Make the connection on the first reachable IP address (skipping the unreachable ones next time)
+        beast::get_lowest_layer(stream).expires_after(std::chrono::seconds(30));
+        auto const endpoint = co_await beast::get_lowest_layer(stream).async_connect(endpoints, net::use_awaitable);
+        dnsCache.promote(this->host_, this->port_, endpoint);
+
+        // Set SNI Hostname, the host name to verify and the session to resume
+        this->tls_.prepare(stream.native_handle(), this->host_);
+
+        // Perform the SSL handshake
+        co_await stream.async_handshake(ssl::stream_base::client, net::use_awaitable);
+        this->tls_.onHandshake(stream.native_handle());
+
+        co_return connection;
+    }
+
+    /* Sends the request on the connection and reads the response */
+    net::awaitable<response_t> AsyncSession::send(Connection &connection, request_t &req)
+    {
+        // Only reusable again once a full response has been read
+        connection.isReusable_ = false;
+
+        req.set(http::field::host, this->host_);
+        req.set(http::field::user_agent, BOOST_BEAST_VERSION_STRING);
+
+        // Apply our headers gotten from the getters
+        for (auto const &decorator : this->requestDecorators_)
+            decorator(req);
+
+        // Set our custom headers - overrides any decorator-added headers
+        for (auto const &pair : this->headers_)
+            req.set(std::get<0>(pair), std::get<1>(pair));
+
+        // Prepare the payload if there are any
+        if (req.body().length())
+            req.prepare_payload();
+
+        // Send the HTTP request to the remote host
+        beast::get_lowest_layer(connection.stream_).expires_after(std::chrono::seconds(30));
+        co_await http::async_write(connection.stream_, req, net::use_awaitable);
+
+        // Receive the HTTP response straight into a string body
+        response_t res;
+        co_await http::async_read(connection.stream_, connection.buffer_, res, net::use_awaitable);
+        beast::get_lowest_layer(connection.stream_).expires_never();
+
+        connection.isReusable_ = res.keep_alive();
+
+        // Rate-limited or failed on the host's side, nothing to parse
+        if (StatusError::isRetryable(res.result_int()))
+            throw StatusError(res.result_int(), std::string(res.reason()));
+
+        co_return res;
+    }
+}
@@ -0,0 +1,121 @@
+#include "cryptoconnect/helpers/network/http/rate_limiter.hpp"
+
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace Network::HTTP
+{
+    namespace
+    {
+        int64_t steadyNow()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now().time_since_epoch())
+                .count();
+        }
+    }
+
+    /* Constructor */
+    RateLimiter::RateLimiter(double ratePerSecond, size_t burst)
+        : interval_((int64_t)(1e9 / ratePerSecond))
+    {
+        // Each priority below the first leaves another quarter of the burst to the ones above
+        int64_t const tolerance = this->interval_ * (int64_t)(burst ? burst - 1 : 0);
+        for (int priority = 0; priority < 3; priority++)
+            this->tolerances_[priority] = tolerance * (4 - priority) / 4;
+    }
+
+    /* Blocks until the request can be sent */
+    void RateLimiter::acquire(Priority priority, std::string const &endpoint)
+    {
+        int64_t waited = 0;
+        bool isReserved = false;
+        while (!isReserved)
+        {
+            int64_t const wait = this->reserve(priority, isReserved);
+            if (wait > 0)
+            {
+                std::this_thread::sleep_for(std::chrono::nanoseconds(wait));
+                waited += wait;
+            }
+        }
+
+        this->record(endpoint, waited);
+    }
+
+    /* Awaits until the request can be sent */
+    boost::asio::awaitable<void> RateLimiter::asyncAcquire(Priority priority, std::string endpoint)
+    {
+        boost::asio::steady_timer timer(co_await boost::asio::this_coro::executor);
+
+        int64_t waited = 0;
+        bool isReserved = false;
+        while (!isReserved)
+        {
+            int64_t const wait = this->reserve(priority, isReserved);
+            if (wait > 0)
+            {
+                timer.expires_after(std::chrono::nanoseconds(wait));
+                co_await timer.async_wait(boost::asio::use_awaitable);
+                waited += wait;
+            }
+        }
+
+        this->record(endpoint, waited);
+    }
+
+    /* Reads the per-endpoint counters */
+    void RateLimiter::getStats(throttleStats_t &output)
+    {
+        std::lock_guard<std::mutex> lock(this->statsMutex_);
+        output = this->stats_;
+    }
+
+    /* Takes a token or returns how long to wait before trying again */
+    int64_t RateLimiter::reserve(Priority priority, bool &isReserved)
+    {
+        int64_t const tolerance = this->tolerances_[(size_t)priority];
+        int64_t const now = steadyNow();
+
+        int64_t theoreticalTime = this->theoreticalTime_.load(std::memory_order_relaxed);
+        while (1)
+        {
+            int64_t const due = std::max(theoreticalTime, now);
+
+            // Lower priorities never queue up ahead of the higher ones: come back once the token is there
+            if (priority != Priority::HIGH && due - now > tolerance)
+            {
+                isReserved = false;
+                return due - now - tolerance;
+            }
+
+            if (this->theoreticalTime_.compare_exchange_weak(
+                    theoreticalTime, due + this->interval_, std::memory_order_relaxed))
+            {
+                isReserved = true;
+                return std::max<int64_t>(due - now - tolerance, 0);
+            }
+        }
+    }
+
+    /* Records the wait of an endpoint's request */
+    void RateLimiter::record(std::string const &endpoint, int64_t waitNanoseconds)
+    {
+        std::lock_guard<std::mutex> lock(this->statsMutex_);
+
+        ThrottleStats &stats = this->stats_[endpoint];
+        stats.requests_++;
+        if (waitNanoseconds > 0)
+        {
+            stats.throttled_++;
+            stats.waitNanoseconds_ += waitNanoseconds;
+            stats.maxWaitNanoseconds_ = std::max<uint64_t>(stats.maxWaitNanoseconds_, waitNanoseconds);
+        }
+    }
+}
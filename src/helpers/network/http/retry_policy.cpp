@@ -0,0 +1,36 @@
+#include "cryptoconnect/helpers/network/http/retry_policy.hpp"
+
+#include "cryptoconnect/helpers/network/http/session.hpp"
+
+#include <boost/system/system_error.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <random>
+
+namespace Network::HTTP
+{
+    /* Whether the request that failed with the exception should be retried */
+    bool RetryPolicy::isRetryable(std::exception const &e, bool isIdempotent) const
+    {
+        if (auto const *statusError = dynamic_cast<StatusError const *>(&e))
+            return statusError->getStatus() == 429 || isIdempotent;
+
+        // Socket and TLS errors
+        return isIdempotent && dynamic_cast<boost::system::system_error const *>(&e);
+    }
+
+    /* Random wait before the given retry */
+    std::chrono::nanoseconds RetryPolicy::backoff(size_t retry) const
+    {
+        thread_local std::mt19937_64 generator{std::random_device{}()};
+
+        // Spread the retries of requests that failed together so they do not hit the host together again
+        auto const cap = std::min<std::chrono::nanoseconds>(
+            this->maxBackoff_, this->baseBackoff_ * (1ull << std::min<size_t>(retry - 1, 20)));
+        std::uniform_int_distribution<int64_t> distribution(0, cap.count());
+
+        return std::chrono::nanoseconds(distribution(generator));
+    }
+}
@@ -1,5 +1,9 @@
 #include "cryptoconnect/helpers/network/http/session.hpp"
 
+#include "cryptoconnect/helpers/network/dns/cache.hpp"
+#include "cryptoconnect/helpers/network/tls/context.hpp"
+#include "cryptoconnect/helpers/network/tls/liveness.hpp"
+
 #include <boost/beast/core.hpp>
 #include <boost/beast/http.hpp>
 #include <boost/beast/ssl.hpp>
@@ -9,13 +13,16 @@
 #include <boost/asio/ssl/error.hpp>
 #include <boost/asio/ssl/stream.hpp>
 
+#include <span>
 #include <string>
+#include <string_view>
+#include <utility>
 
 namespace Network::HTTP
 {
     /* Constructor */
     Session::Session(char const *host, char const *port)
-        : host_(host), port_(port) { this->initSession(); }
+        : tls_(TLS::Context::shared(host)), host_(host), port_(port) { this->initSession(); }
 
     void Session::addHeaders(headers_t const headers)
     {
@@ -30,11 +37,8 @@ namespace Network::HTTP
     /* HTTP GET Request */
     void Session::get(char const *target, std::string &output)
     {
-        // Set up an HTTP POST request message
-        request_t req{http::verb::get, target, 11};
-
-        // Make the request
-        this->request(req, output);
+        auto const response = this->get(target);
+        output.append(response.data(), response.size());
     }
 
     /* HTTP POST Request (r-value body) */
@@ -47,80 +51,78 @@ namespace Network::HTTP
     /* HTTP POST Request (l-value body) */
     void Session::post(char const *target, std::string &output, std::string const &body)
     {
-        // Set up an HTTP POST request message
-        request_t req{http::verb::post, target, 11};
-
-        // Set the body and make the request
-        req.body() = body;
-        this->request(req, output);
+        auto const response = this->post(target, body);
+        output.append(response.data(), response.size());
     }
 
     void Session::del(char const *target, std::string &output)
     {
-        // Set up an HTTP DELETE request message
-        request_t req{http::verb::delete_, target, 11};
-
-        // Make the request
-        this->request(req, output);
+        auto const response = this->del(target);
+        output.append(response.data(), response.size());
     }
 
-    /* Private constructor to replicate a session for isolated requests */
-    Session::Session(Session *session)
+    /* HTTP GET Request (in place) */
+    std::span<char> Session::get(char const *target)
     {
-        this->host_ = session->host_;
-        this->port_ = session->port_;
-        this->headers_ = (session->headers_);
-        this->requestDecorators_ = session->requestDecorators_;
+        // Set up an HTTP GET request message
+        request_t req{http::verb::get, target, 11};
 
-        this->initSession();
+        // Make the request
+        return this->request(req);
     }
 
-    /* HTTP GET Request in a separate session - facilitates multithreading */
-    void Session::isolatedGet(char const *target, std::string &output)
+    /* HTTP POST Request (in place) */
+    std::span<char> Session::post(char const *target, std::string_view body)
     {
-        // Replicate the session
-        Session session(this);
-        session.get(target, output);
+        // Set up an HTTP POST request message
+        request_t req{http::verb::post, target, 11};
+
+        // Set the body and make the request
+        req.body() = body;
+        return this->request(req);
     }
 
-    /* HTTP POST Request in a separate session - facilitates multithreading */
-    void Session::isolatedPost(char const *target, std::string &output)
+    /* HTTP DELETE Request (in place) */
+    std::span<char> Session::del(char const *target)
     {
-        // Replicate the session
-        Session session(this);
-        session.post(target, output);
+        // Set up an HTTP DELETE request message
+        request_t req{http::verb::delete_, target, 11};
+
+        // Make the request
+        return this->request(req);
     }
 
-    void Session::isolatedDel(char const *target, std::string &output)
+    /* Whether the idle connection is still open and can take another request */
+    bool Session::isHealthy()
     {
-        // Replicate the session
-        Session session(this);
-        session.del(target, output);
+        return this->isReusable_ && TLS::isIdleOpen(this->stream_);
     }
 
     /* Called by constuctors to initialize the session */
     void Session::initSession()
     {
-        // Resolve the host and port for the IP
-        auto const resolverResults = this->resolver_.resolve(this->host_, this->port_);
+        // Resolve the host and port for the IPs (cached, only the very first session of the host waits on a lookup)
+        DNS::Cache &dnsCache = DNS::Cache::shared();
+        auto const endpoints = dnsCache.resolve(this->host_, this->port_);
 
-        // Make the connection on the IP address we got from the lookup
-        beast::get_lowest_layer(this->stream_).connect(resolverResults);
+        // Make the connection on the first reachable IP address (skipping the unreachable ones next time)
+        auto const endpoint = beast::get_lowest_layer(this->stream_).connect(endpoints);
+        dnsCache.promote(this->host_, this->port_, endpoint);
 
-        // Set SNI Hostname
-        if (!SSL_set_tlsext_host_name(this->stream_.native_handle(), this->host_))
-        {
-            beast::error_code ec{static_cast<int>(::ERR_get_error()), net::error::get_ssl_category()};
-            throw beast::system_error{ec};
-        }
+        // Set SNI Hostname, the host name to verify and the session to resume
+        this->tls_.prepare(this->stream_.native_handle(), this->host_);
 
         // Perform the SSL handshake
         this->stream_.handshake(ssl::stream_base::client);
+        this->tls_.onHandshake(this->stream_.native_handle());
     }
 
     /* Called by request methods to perform the request */
-    void Session::request(request_t &req, std::string &output)
+    std::span<char> Session::request(request_t &req)
     {
+        // Only reusable again once a full response has been read
+        this->isReusable_ = false;
+
         req.set(http::field::host, this->host_);
         req.set(http::field::user_agent, BOOST_BEAST_VERSION_STRING);
 
@@ -139,18 +141,21 @@ namespace Network::HTTP
         // Send the HTTP request to the remote host
         http::write(this->stream_, req);
 
-        // Declare the containers to hold the response
-        beast::flat_buffer buffer;
-        http::response<http::dynamic_body> res;
+        // Lend the response our body buffer so its capacity is reused (cleared, not shrunk)
+        http::response<http::string_body> res;
+        res.body() = std::move(this->body_);
+        res.body().clear();
+
+        // Receive the HTTP response straight into it
+        http::read(this->stream_, this->buffer_, res);
+        this->isReusable_ = res.keep_alive();
+        this->body_ = std::move(res.body());
 
-        // Receive the HTTP response
-        http::read(this->stream_, buffer, res);
+        // Rate-limited or failed on the host's side, nothing to parse
+        if (StatusError::isRetryable(res.result_int()))
+            throw StatusError(res.result_int(), std::string(res.reason()));
 
-        // Write the repsonse body into the output string
-        for (auto const seq : res.body().data())
-        {
-            auto *cbuf = boost::asio::buffer_cast<char const *>(seq);
-            output.append(cbuf, boost::asio::buffer_size(seq));
-        }
+        // std::string keeps a NUL past the end of its data for in-situ parsers
+        return std::span<char>(this->body_.data(), this->body_.size());
     }
 }
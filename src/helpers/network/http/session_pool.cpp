@@ -0,0 +1,307 @@
+#include "cryptoconnect/helpers/network/http/session_pool.hpp"
+
+#include "cryptoconnect/helpers/network/http/rate_limiter.hpp"
+#include "cryptoconnect/helpers/network/http/session.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+namespace Network::HTTP
+{
+    namespace
+    {
+        /* Runs the handler on the response, keeping its failures apart from the request's (never retried) */
+        std::exception_ptr handleInPlace(responseHandler_t const &handler, std::span<char> response)
+        {
+            try
+            {
+                handler(response);
+            }
+            catch (...)
+            {
+                return std::current_exception();
+            }
+            return nullptr;
+        }
+    }
+
+    /* Returns the session to its pool */
+    SessionPool::Lease::~Lease()
+    {
+        if (this->session_)
+            this->pool_->checkin(std::move(this->session_));
+    }
+
+    /* Constructor */
+    SessionPool::SessionPool(char const *host, char const *port, size_t maxIdle)
+        : host_(host), port_(port), maxIdle_(maxIdle){};
+
+    void SessionPool::addHeaders(headers_t const headers)
+    {
+        this->headers_.insert(headers.begin(), headers.end());
+    }
+
+    void SessionPool::addRequestDecorator(requestDecorator_t decorator)
+    {
+        this->requestDecorators_.push_back(decorator);
+    }
+
+    /* Opens sessions until there are at least numSessions idle ones */
+    void SessionPool::warmUp(size_t numSessions)
+    {
+        while (1)
+        {
+            {
+                std::lock_guard<std::mutex> lock(this->mutex_);
+                if (this->idleSessions_.size() >= std::min(numSessions, this->maxIdle_))
+                    return;
+                // Lock guard goes out of scope and releases (not held while connecting)
+            }
+
+            this->checkin(this->makeSession());
+        }
+    }
+
+    /* Health-checks the idle sessions on a timer */
+    void SessionPool::keepAlive(std::chrono::seconds interval, std::string const pingTarget, size_t minIdle,
+                                RateLimiter *limiter)
+    {
+        std::thread keepAliveThread(
+            [this, interval, pingTarget, minIdle, limiter]
+            {
+                while (1)
+                {
+                    std::this_thread::sleep_for(interval);
+                    try
+                    {
+                        this->maintainIdle(interval, pingTarget, minIdle, limiter);
+                    }
+                    catch (std::exception const &e)
+                    {
+                        std::cerr << "[WARNING] Failed to keep the " << this->host_ << " sessions warm: "
+                                  << e.what() << '\n';
+                    }
+                }
+            });
+
+        keepAliveThread.detach();
+    }
+
+    /* Checks out a healthy idle session or opens a new one */
+    SessionPool::Lease SessionPool::checkout()
+    {
+        while (1)
+        {
+            std::unique_ptr<Session> session;
+            {
+                std::lock_guard<std::mutex> lock(this->mutex_);
+                if (this->idleSessions_.empty())
+                    break;
+
+                // The most recently used session is the least likely to have been closed by the server
+                session = std::move(this->idleSessions_.back().session_);
+                this->idleSessions_.pop_back();
+                // Lock guard goes out of scope and releases
+            }
+
+            if (session->isHealthy())
+            {
+                this->reuses_++;
+                return Lease(this, std::move(session), true);
+            }
+
+            this->drops_++;
+        }
+
+        return Lease(this, this->makeSession(), false);
+    }
+
+    /* Reads the counters */
+    void SessionPool::getStats(PoolStats &output)
+    {
+        output.connects_ = this->connects_.load(std::memory_order_relaxed);
+        output.reuses_ = this->reuses_.load(std::memory_order_relaxed);
+        output.retries_ = this->retries_.load(std::memory_order_relaxed);
+        output.drops_ = this->drops_.load(std::memory_order_relaxed);
+    }
+
+    /* HTTP GET Request */
+    void SessionPool::get(char const *target, std::string &output)
+    {
+        this->requestIdempotent(
+            [target, &output](Session &session)
+            { session.get(target, output); });
+    }
+
+    /* HTTP POST Request (never retried, the exchange may have acted on it) */
+    void SessionPool::post(char const *target, std::string &output, std::string const &body)
+    {
+        Lease lease = this->checkout();
+        lease->post(target, output, body);
+    }
+
+    /* HTTP Delete Request */
+    void SessionPool::del(char const *target, std::string &output)
+    {
+        this->requestIdempotent(
+            [target, &output](Session &session)
+            { session.del(target, output); });
+    }
+
+    /* HTTP GET Request (in place) */
+    void SessionPool::get(char const *target, responseHandler_t const &handler)
+    {
+        std::exception_ptr handlerFailure;
+        this->requestIdempotent(
+            [target, &handler, &handlerFailure](Session &session)
+            { handlerFailure = handleInPlace(handler, session.get(target)); });
+
+        if (handlerFailure)
+            std::rethrow_exception(handlerFailure);
+    }
+
+    /* HTTP POST Request (in place, never retried) */
+    void SessionPool::post(char const *target, std::string_view body, responseHandler_t const &handler)
+    {
+        Lease lease = this->checkout();
+        handler(lease->post(target, body));
+    }
+
+    /* HTTP Delete Request (in place) */
+    void SessionPool::del(char const *target, responseHandler_t const &handler)
+    {
+        std::exception_ptr handlerFailure;
+        this->requestIdempotent(
+            [target, &handler, &handlerFailure](Session &session)
+            { handlerFailure = handleInPlace(handler, session.del(target)); });
+
+        if (handlerFailure)
+            std::rethrow_exception(handlerFailure);
+    }
+
+    /* Opens a new session with the pool's headers and decorators */
+    std::unique_ptr<Session> SessionPool::makeSession()
+    {
+        auto session = std::make_unique<Session>(this->host_, this->port_);
+        session->addHeaders(this->headers_);
+        for (auto const &decorator : this->requestDecorators_)
+            session->addRequestDecorator(decorator);
+
+        this->connects_++;
+        return session;
+    }
+
+    /* Returns a session to the idle ones */
+    void SessionPool::checkin(std::unique_ptr<Session> session)
+    {
+        // Guard clause for sessions left unusable by their last request
+        if (!session->isHealthy())
+        {
+            this->drops_++;
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        this->idleSessions_.push_back({std::move(session), std::chrono::steady_clock::now()});
+
+        // Close the least recently used sessions in excess
+        while (this->idleSessions_.size() > this->maxIdle_)
+            this->idleSessions_.pop_front();
+        // Lock guard goes out of scope and releases
+    }
+
+    /* Performs an idempotent request, retrying once on a fresh session if a reused one failed */
+    template <typename Request>
+    void SessionPool::requestIdempotent(Request request)
+    {
+        {
+            Lease lease = this->checkout();
+            bool const isReused = lease.isReused();
+
+            try
+            {
+                request(*lease);
+                return;
+            }
+            catch (StatusError const &e)
+            {
+                // The connection is fine, the host answered
+                throw;
+            }
+            catch (std::exception const &e)
+            {
+                lease.discard();
+
+                // Only a reused connection may have been closed by the server in between
+                if (!isReused)
+                    throw;
+            }
+        }
+
+        this->retries_++;
+        Lease lease(this, this->makeSession(), false);
+        request(*lease);
+    }
+
+    /* Health-checks and pings the idle sessions */
+    void SessionPool::maintainIdle(std::chrono::seconds interval, std::string const &pingTarget, size_t minIdle,
+                                   RateLimiter *limiter)
+    {
+        auto const now = std::chrono::steady_clock::now();
+
+        // Take out the sessions due for a ping, dropping the ones already closed
+        std::deque<std::unique_ptr<Session>> dueSessions;
+        {
+            std::lock_guard<std::mutex> lock(this->mutex_);
+            for (auto it = this->idleSessions_.begin(); it != this->idleSessions_.end();)
+            {
+                if (!it->session_->isHealthy())
+                {
+                    this->drops_++;
+                    it = this->idleSessions_.erase(it);
+                }
+                else if (now - it->lastUsed_ >= interval)
+                {
+                    dueSessions.push_back(std::move(it->session_));
+                    it = this->idleSessions_.erase(it);
+                }
+                else
+                    it++;
+            }
+            // Lock guard goes out of scope and releases (not held while pinging)
+        }
+
+        std::string const endpoint = "GET " + pingTarget;
+        for (auto &session : dueSessions)
+        {
+            // Metered behind every other request
+            if (limiter)
+                limiter->acquire(Priority::LOW, endpoint);
+
+            try
+            {
+                std::string response;
+                session->get(pingTarget.c_str(), response);
+            }
+            catch (std::exception const &e)
+            {
+                this->drops_++;
+                continue;
+            }
+
+            this->checkin(std::move(session));
+        }
+
+        // Replace whatever was dropped
+        this->warmUp(minIdle);
+    }
+}
@@ -0,0 +1,136 @@
+#include "cryptoconnect/helpers/network/tls/context.hpp"
+
+#include <boost/asio/error.hpp>
+#include <boost/asio/ssl/context.hpp>
+#include <boost/asio/ssl/error.hpp>
+#include <boost/system/system_error.hpp>
+
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+namespace Network::TLS
+{
+    namespace
+    {
+        /* Slot of the SSL_CTX holding its Context (app data is taken by Asio for the verify callback) */
+        int contextIndex()
+        {
+            static int const index = SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+            return index;
+        }
+    }
+
+    /* Constructor */
+    Context::Context()
+    {
+        SSL_CTX *ctx = this->ctx_.native_handle();
+
+        // Actually check who we are talking to
+        this->ctx_.set_default_verify_paths();
+        this->ctx_.set_verify_mode(ssl::verify_peer);
+
+        if (!SSL_CTX_set_ciphersuites(ctx, TLS_CIPHERSUITES))
+            throw std::runtime_error("Failed to set the TLS ciphersuites");
+
+        // Keep the sessions ourselves (OpenSSL's internal cache is server-side only in practice)
+        SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+        SSL_CTX_sess_set_new_cb(ctx, &Context::onNewSession);
+        if (contextIndex() < 0 || !SSL_CTX_set_ex_data(ctx, contextIndex(), this))
+            throw std::runtime_error("Failed to attach the TLS context");
+    }
+
+    /* Destructor */
+    Context::~Context()
+    {
+        for (auto &pair : this->sessions_)
+            SSL_SESSION_free(pair.second);
+    }
+
+    /* Context shared by all the connections to the host */
+    Context &Context::shared(std::string const &host)
+    {
+        // Never destroyed: OpenSSL cleans up at exit before static destructors registered earlier would run
+        static auto *contexts = new std::unordered_map<std::string, std::unique_ptr<Context>>();
+        static std::mutex contextsMutex;
+
+        std::lock_guard<std::mutex> lock(contextsMutex);
+        auto &context = (*contexts)[host];
+        if (!context)
+            context = std::make_unique<Context>();
+
+        return *context;
+    }
+
+    ssl::context &Context::getContext()
+    {
+        return this->ctx_;
+    }
+
+    /* Sets up a connection before its handshake */
+    void Context::prepare(SSL *ssl, std::string const &host)
+    {
+        // Set SNI Hostname
+        if (!SSL_set_tlsext_host_name(ssl, host.c_str()))
+        {
+            boost::system::error_code ec{static_cast<int>(::ERR_get_error()), boost::asio::error::get_ssl_category()};
+            throw boost::system::system_error{ec};
+        }
+
+        // The certificate has to be for the host
+        if (!SSL_set1_host(ssl, host.c_str()))
+            throw std::runtime_error("Failed to set the host name to verify");
+
+        // Resume the last session if there is one (the connection takes its own reference)
+        std::lock_guard<std::mutex> lock(this->sessionsMutex_);
+        auto const session = this->sessions_.find(host);
+        if (session != this->sessions_.end())
+            SSL_set_session(ssl, session->second);
+        // Lock guard goes out of scope and releases
+    }
+
+    /* Records a completed handshake */
+    void Context::onHandshake(SSL *ssl)
+    {
+        this->handshakes_++;
+        if (SSL_session_reused(ssl))
+            this->resumptions_++;
+    }
+
+    /* Reads the counters */
+    void Context::getStats(Stats &output)
+    {
+        output.handshakes_ = this->handshakes_.load(std::memory_order_relaxed);
+        output.resumptions_ = this->resumptions_.load(std::memory_order_relaxed);
+    }
+
+    /* Called by OpenSSL with every new session ticket */
+    int Context::onNewSession(SSL *ssl, SSL_SESSION *session)
+    {
+        Context *context = static_cast<Context *>(SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), contextIndex()));
+        char const *host = SSL_get_servername(ssl, TLSEXT_NAMETYPE_host_name);
+
+        // Guard clause for connections made without SNI (not resumable by host)
+        if (!context || !host)
+            return 0;
+
+        // Keep a copy: the connection's own session is invalidated if it is dropped without a shutdown
+        SSL_SESSION *copy = SSL_SESSION_dup(session);
+        if (!copy)
+            return 0;
+
+        std::lock_guard<std::mutex> lock(context->sessionsMutex_);
+        SSL_SESSION *&cached = context->sessions_[host];
+        if (cached)
+            SSL_SESSION_free(cached);
+        cached = copy;
+
+        // Returning 0 leaves the original to OpenSSL
+        return 0;
+    }
+}
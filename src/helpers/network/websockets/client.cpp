@@ -1,37 +1,105 @@
 #include "cryptoconnect/helpers/network/websockets/client.hpp"
 
+#include "cryptoconnect/helpers/network/dns/cache.hpp"
+#include "cryptoconnect/helpers/network/tls/context.hpp"
+
 #include <boost/beast/core.hpp>
 #include <boost/beast/ssl.hpp>
 #include <boost/beast/websocket.hpp>
 #include <boost/beast/websocket/ssl.hpp>
-#include <boost/asio/connect.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
 #include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/asio/ssl/stream.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+#include <openssl/bio.h>
+#include <openssl/ssl.h>
 
+#include <chrono>
+#include <ctime>
+#include <iostream>
+#include <memory>
+#include <span>
 #include <string>
+#include <thread>
 
 namespace Network::WebSockets
 {
-    /* Connector to initialize the context */
-    void Client::connect(char const *host, char const *port, char const *target)
+#ifdef WEBSOCKETS_PROFILE_READS
+    namespace
     {
-        // Resolve the host and port for the IP
-        auto const resolverResults = this->resolver_.resolve(host, port);
-
-        // Make the connection on the IP address we got from the lookup
-        net::connect(this->ws_.next_layer().next_layer(), resolverResults.begin(), resolverResults.end());
-
-        // Set SNI Hostname
-        if (!SSL_set_tlsext_host_name(this->ws_.next_layer().native_handle(), host))
+        /* CPU time consumed by the calling thread (excludes time blocked waiting for data) */
+        inline uint64_t threadCpuNanoseconds()
         {
-            throw std::runtime_error("Failed to set host name");
+            timespec ts;
+            clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+            return ts.tv_sec * 1000000000ull + ts.tv_nsec;
         }
+    }
+#endif
+
+    /* Constructor */
+    Client::Client(net::io_context &ioc)
+        : ioc_(ioc), strand_(net::make_strand(ioc)) {}
+
+    strand_t &Client::getStrand()
+    {
+        return this->strand_;
+    }
+
+    /* Sets the compression to offer on subsequent connects */
+    void Client::setCompression(Compression const &compression)
+    {
+        this->compression_ = compression;
+    }
+
+    /* Connects to the host */
+    net::awaitable<void> Client::connect(std::string host, std::string port, std::string target)
+    {
+        this->host_ = host;
+        this->port_ = port;
+        this->target_ = target;
+        this->tls_ = &TLS::Context::shared(host);
+
+        co_await this->reconnect();
+    }
+
+    /* Replaces the stream with a fresh connection to the last connected host */
+    net::awaitable<void> Client::reconnect()
+    {
+        // Guard clause for a client that never connected
+        if (!this->tls_)
+            throw std::runtime_error("Websocket has no host to reconnect to");
+
+        this->isConnected_ = false;
+
+        // Build the new stream aside, the old one is only released once its pending operations let go of it
+        auto ws = std::make_shared<stream_t>(this->strand_, this->tls_->getContext());
+
+        // Resolve the host and port for the IPs (cached, a first lookup is awaited without blocking the io thread)
+        DNS::Cache &dnsCache = DNS::Cache::shared();
+        auto const endpoints = co_await dnsCache.asyncResolve(this->host_, this->port_);
+
+        // Make the connection on the first reachable IP address (skipping the unreachable ones next time)
+        beast::get_lowest_layer(*ws).expires_after(std::chrono::seconds(30));
+        auto const endpoint = co_await beast::get_lowest_layer(*ws).async_connect(endpoints, net::use_awaitable);
+        dnsCache.promote(this->host_, this->port_, endpoint);
 
-        // Perform the SSL handshake
-        this->ws_.next_layer().handshake(ssl::stream_base::client);
+        // Set SNI Hostname, the host name to verify and the session to resume
+        this->tls_->prepare(ws->next_layer().native_handle(), this->host_);
+
+        // Perform the SSL handshake (resumed when the host handed out a ticket on a previous connection)
+        co_await ws->next_layer().async_handshake(ssl::stream_base::client, net::use_awaitable);
+        this->tls_->onHandshake(ws->next_layer().native_handle());
+
+        // The websocket stream manages its own timeouts from here on
+        beast::get_lowest_layer(*ws).expires_never();
+        ws->set_option(websocket::stream_base::timeout::suggested(beast::role_type::client));
 
         // Set a decorator to change the User-Agent of the handshake
-        this->ws_.set_option(websocket::stream_base::decorator(
+        ws->set_option(websocket::stream_base::decorator(
             [](websocket::request_type &req)
             {
                 req.set(
@@ -39,33 +107,175 @@ namespace Network::WebSockets
                     std::string(BOOST_BEAST_VERSION_STRING) + " websocket-client-coro");
             }));
 
-        // Perform the websocket handshake
-        this->ws_.handshake(host, target);
+        // Offer permessage-deflate (frames are then inflated straight into our read buffers)
+        websocket::permessage_deflate deflateOption;
+        deflateOption.client_enable = this->compression_.isEnabled_;
+        deflateOption.server_max_window_bits = this->compression_.serverMaxWindowBits_;
+        deflateOption.client_max_window_bits = this->compression_.clientMaxWindowBits_;
+        ws->set_option(deflateOption);
+
+        // Perform the websocket handshake, the host only compresses if its response agrees to the extension
+        websocket::response_type response;
+        co_await ws->async_handshake(response, this->host_, this->target_, net::use_awaitable);
+        bool const isCompressed =
+            this->compression_.isEnabled_ &&
+            response[http::field::sec_websocket_extensions].find("permessage-deflate") != beast::string_view::npos;
+
+        // Swap the new stream in
+        {
+            std::lock_guard<std::mutex> lock(this->mutex_);
+            if (this->ws_)
+                this->previousWireBytes_ += BIO_number_read(SSL_get_rbio(this->ws_->next_layer().native_handle()));
+            this->ws_ = ws;
+            // Lock guard goes out of scope and releases
+        }
+
+        this->isCompressed_.store(isCompressed, std::memory_order_relaxed);
+
+        this->isConnected_ = true;
     }
 
-    void Client::ping(char const *const message)
+    /* Reads the counters */
+    void Client::getStats(Stats &output)
     {
-        this->ws_.ping(message);
+        output.frames_ = this->frames_.load(std::memory_order_relaxed);
+        output.payloadBytes_ = this->payloadBytes_.load(std::memory_order_relaxed);
+        output.readCpuNanoseconds_ = this->readCpuNanoseconds_.load(std::memory_order_relaxed);
+        output.ioCpuNanoseconds_ = 0;
+        output.isCompressed_ = this->isCompressed_.load(std::memory_order_relaxed);
+
+        // Ciphertext read by OpenSSL off the transport
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        output.wireBytes_ = this->previousWireBytes_.load(std::memory_order_relaxed);
+        if (this->ws_)
+            output.wireBytes_ += BIO_number_read(SSL_get_rbio(this->ws_->next_layer().native_handle()));
+        // Lock guard goes out of scope and releases
     }
 
-    /* Writes a message to the host (r-value) */
-    void Client::write(std::string const &&message)
+    /* Pings the host on a timer */
+    void Client::keepAlive(std::chrono::seconds interval)
     {
-        // Message becomes l-value in this scope
-        this->write(message);
+        net::co_spawn(this->strand_, this->pingForever(interval), net::detached);
     }
 
-    /* Writes a message to the host (l-value) */
-    void Client::write(std::string const &message)
+    /* Pings on every tick of the timer */
+    net::awaitable<void> Client::pingForever(std::chrono::seconds interval)
     {
-        this->ws_.write(net::buffer(message));
+        while (1)
+        {
+            this->pingTimer_.expires_after(interval);
+            co_await this->pingTimer_.async_wait(net::use_awaitable);
+
+            // Dropped connections are noticed and recovered by their readers
+            if (!this->isConnected_)
+                continue;
+
+            auto ws = this->ws_;
+            try
+            {
+                co_await ws->async_ping("keepalive", net::use_awaitable);
+            }
+            catch (std::exception const &e)
+            {
+                std::cerr << "[WARNING] Keepalive ping failed: " << e.what() << '\n';
+            }
+        }
     }
 
-    /* Reads a message from the host */
-    void Client::read(std::string &output)
+    /* Queues a message to be written to the host */
+    void Client::write(std::string message)
     {
-        this->buffer_.clear();
-        this->ws_.read(this->buffer_);
-        output = boost::beast::buffers_to_string(this->buffer_.cdata());
+        net::post(
+            this->strand_,
+            [this, message = std::move(message)]() mutable
+            {
+                // Whoever reconnects is responsible for replaying what matters
+                if (!this->isConnected_)
+                {
+                    std::cerr << "[WARNING] Dropped message written while disconnected" << '\n';
+                    return;
+                }
+
+                this->writeQueue_.push_back(std::move(message));
+
+                // Guard clause for a writer already draining the queue
+                if (this->isWriting_)
+                    return;
+
+                this->isWriting_ = true;
+                net::co_spawn(this->strand_, this->writeQueued(), net::detached);
+            });
+    }
+
+    /* Writes the queued messages out one at a time */
+    net::awaitable<void> Client::writeQueued()
+    {
+        while (this->writeQueue_.size())
+        {
+            auto ws = this->ws_;
+            bool hasFailed = false;
+
+            try
+            {
+                co_await ws->async_write(net::buffer(this->writeQueue_.front()), net::use_awaitable);
+            }
+            catch (std::exception const &e)
+            {
+                std::cerr << "[WARNING] Websocket write failed: " << e.what() << '\n';
+                hasFailed = true;
+            }
+
+            // The current stream failed: drop everything, its reader takes care of reconnecting
+            if (hasFailed && ws == this->ws_)
+            {
+                this->writeQueue_.clear();
+                break;
+            }
+
+            this->writeQueue_.pop_front();
+        }
+
+        this->isWriting_ = false;
+    }
+
+    /* Reads a message from the host into the given buffer */
+    net::awaitable<std::span<char>> Client::read(beast::flat_buffer &buffer)
+    {
+        auto ws = this->ws_;
+        if (!ws)
+            throw std::runtime_error("Websocket is not connected");
+
+        buffer.clear();
+
+#ifdef WEBSOCKETS_PROFILE_READS
+        auto const readThread = std::this_thread::get_id();
+        uint64_t const readStart = threadCpuNanoseconds();
+#endif
+
+        std::size_t size;
+        try
+        {
+            size = co_await ws->async_read(buffer, net::use_awaitable);
+        }
+        catch (std::exception const &e)
+        {
+            // Stop accepting writes until reconnected
+            this->isConnected_ = false;
+            throw;
+        }
+
+#ifdef WEBSOCKETS_PROFILE_READS
+        // Only meaningful if resumed on the same thread (includes any other handler it ran while the read was pending)
+        if (std::this_thread::get_id() == readThread)
+            this->readCpuNanoseconds_.fetch_add(threadCpuNanoseconds() - readStart, std::memory_order_relaxed);
+#endif
+
+        this->frames_.fetch_add(1, std::memory_order_relaxed);
+        this->payloadBytes_.fetch_add(size, std::memory_order_relaxed);
+
+        // NUL-terminate past the readable bytes (may reallocate, so take the data pointer after)
+        static_cast<char *>(buffer.prepare(1).data())[0] = '\0';
+
+        co_return std::span<char>(static_cast<char *>(buffer.data().data()), size);
     }
 }